@@ -4,7 +4,7 @@
 Write-Host "🔨 Compiling C++ entropy engine to WebAssembly..." -ForegroundColor Cyan
 
 # Create output directory
-New-Item -ItemType Directory -Force -Path "src\entropy-wasm\build" | Out-Null
+New-Item -ItemType Directory -Force -Path "src\entropy-wasm\build\node" | Out-Null
 
 # Check if emcc is available
 if (-not (Get-Command emcc -ErrorAction SilentlyContinue)) {
@@ -23,14 +23,22 @@ if (-not (Get-Command emcc -ErrorAction SilentlyContinue)) {
     cd ..
 }
 
+# ENTROPY_STATS=0 compiles out the getStats counters and phase timers
+$stats = if ($env:ENTROPY_STATS) { $env:ENTROPY_STATS } else { "1" }
+
+# ENTROPY_INITIAL_MEMORY sets the starting heap; modules start small and grow on demand
+$initialMemory = if ($env:ENTROPY_INITIAL_MEMORY) { $env:ENTROPY_INITIAL_MEMORY } else { "16MB" }
+
 # Compile with Emscripten for maximum performance
-$compileCommand = @"
+function Invoke-EntropyBuild([string]$output, [string]$extraFlags) {
+    $compileCommand = @"
 emcc src/entropy-wasm/entropy.cpp `
-  -o src/entropy-wasm/build/entropy.js `
+  -o src/entropy-wasm/build/$output `
   -s WASM=1 `
-  -s EXPORTED_RUNTIME_METHODS='["cwrap", "ccall"]' `
+  -s EXPORTED_RUNTIME_METHODS='["cwrap", "ccall", "HEAPU8"]' `
   -s ALLOW_MEMORY_GROWTH=1 `
   -s MODULARIZE=1 `
+  -s EXPORT_ES6=1 `
   -s EXPORT_NAME='EntropyModule' `
   -s ENVIRONMENT='web,worker' `
   -s USE_ES6_IMPORT_META=0 `
@@ -38,24 +46,40 @@ emcc src/entropy-wasm/entropy.cpp `
   -O3 `
   -s ASSERTIONS=0 `
   --bind `
-  -s TOTAL_MEMORY=134217728 `
+  -s INITIAL_MEMORY=$initialMemory `
   -s MAXIMUM_MEMORY=536870912 `
   -s FAST_UNROLLED_LOOPS=1 `
-  -s AGGRESSIVE_VARIABLE_ELIMINATION=1
+  -s AGGRESSIVE_VARIABLE_ELIMINATION=1 `
+  -DENTROPY_ENABLE_STATS=$stats $extraFlags
 "@
+    Invoke-Expression $compileCommand
+    return $LASTEXITCODE
+}
 
 Write-Host "🚀 Starting compilation..." -ForegroundColor Yellow
-Invoke-Expression $compileCommand
+$exitCode = Invoke-EntropyBuild "entropy.js" ""
+
+if ($exitCode -eq 0) {
+    Write-Host "⚡ Compiling SIMD variant..." -ForegroundColor Yellow
+    $exitCode = Invoke-EntropyBuild "entropy-simd.js" "-msimd128"
+}
 
-if ($LASTEXITCODE -eq 0) {
+if ($exitCode -eq 0) {
+    Write-Host "🖥️ Compiling Node variant for offline tools..." -ForegroundColor Yellow
+    $exitCode = Invoke-EntropyBuild "node/entropy.mjs" "-msimd128 -s ENVIRONMENT='node'"
+}
+
+if ($exitCode -eq 0) {
     Write-Host "✅ WebAssembly compilation successful!" -ForegroundColor Green
     Write-Host "📁 Generated files:" -ForegroundColor Cyan
-    Write-Host "   - src/entropy-wasm/build/entropy.js" -ForegroundColor White
-    Write-Host "   - src/entropy-wasm/build/entropy.wasm" -ForegroundColor White
+    Get-ChildItem "src\entropy-wasm\build\entropy*" | ForEach-Object {
+        Write-Host "   - src/entropy-wasm/build/$($_.Name)" -ForegroundColor White
+    }
     
     # Copy files to public directory for web access
-    Copy-Item "src\entropy-wasm\build\entropy.wasm" "public\" -Force
-    Write-Host "   - public/entropy.wasm (copied for web access)" -ForegroundColor White
+    Copy-Item "src\entropy-wasm\build\entropy*.wasm" "public\" -Force
+    Copy-Item "src\entropy-wasm\build\entropy*.js" "public\" -Force
+    Write-Host "   - public/entropy*.{js,wasm} (copied for web access)" -ForegroundColor White
     
     Write-Host "🚀 Ready for ultra-fast entropy calculations!" -ForegroundColor Green
 } else {
@@ -63,4 +87,4 @@ if ($LASTEXITCODE -eq 0) {
     Write-Host "💡 You may need to install Emscripten manually:" -ForegroundColor Yellow
     Write-Host "   https://emscripten.org/docs/getting_started/downloads.html" -ForegroundColor Yellow
     exit 1
-}
\ No newline at end of file
+}
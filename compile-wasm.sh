@@ -1,42 +1,68 @@
 #!/bin/bash
 # WebAssembly compilation script for high-performance entropy calculations
+#
+# Builds the variants of the engine, all single-threaded (the app runs one per pool worker):
+#   entropy.js / entropy.wasm           - scalar, runs everywhere
+#   entropy-simd.js / entropy-simd.wasm - SIMD128 kernels
+#   node/entropy.mjs                    - Node build for offline tools (scripts/build-opening-tables.mjs)
+#
+# ENTROPY_STATS=0 compiles out the getStats counters and phase timers (default: 1).
+# ENTROPY_INITIAL_MEMORY sets the starting heap (default: 16MB). Modules start small so they
+# instantiate fast on mobile; the heap grows on demand up to MAXIMUM_MEMORY as lists and
+# matrices are loaded.
 
 echo "🔨 Compiling C++ entropy engine to WebAssembly..."
 
+STATS="${ENTROPY_STATS:-1}"
+INITIAL_MEMORY="${ENTROPY_INITIAL_MEMORY:-16MB}"
+
 # Create output directory
-mkdir -p src/entropy-wasm/build
+mkdir -p src/entropy-wasm/build/node
 
 # Compile with Emscripten for maximum performance
-emcc src/entropy-wasm/entropy.cpp \
-  -o src/entropy-wasm/build/entropy.js \
-  -s WASM=1 \
-  -s EXPORTED_RUNTIME_METHODS='["cwrap", "ccall"]' \
-  -s ALLOW_MEMORY_GROWTH=1 \
-  -s MODULARIZE=1 \
-  -s EXPORT_NAME='EntropyModule' \
-  -s ENVIRONMENT='web,worker' \
-  -s USE_ES6_IMPORT_META=0 \
-  -s SINGLE_FILE=0 \
-  -O3 \
-  -s ASSERTIONS=0 \
-  --bind \
-  -s TOTAL_MEMORY=128MB \
-  -s MAXIMUM_MEMORY=512MB \
-  -s FAST_UNROLLED_LOOPS=1 \
-  -s AGGRESSIVE_VARIABLE_ELIMINATION=1
-
-if [ $? -eq 0 ]; then
-    echo "✅ WebAssembly compilation successful!"
-    echo "📁 Generated files:"
-    echo "   - src/entropy-wasm/build/entropy.js"
-    echo "   - src/entropy-wasm/build/entropy.wasm"
-    
-    # Copy files to public directory for web access
-    cp src/entropy-wasm/build/entropy.wasm public/
-    echo "   - public/entropy.wasm (copied for web access)"
-    
-    echo "🚀 Ready for ultra-fast entropy calculations!"
-else
-    echo "❌ WebAssembly compilation failed!"
-    exit 1
-fi
\ No newline at end of file
+compile_variant() {
+  local output="$1"
+  shift
+
+  emcc src/entropy-wasm/entropy.cpp \
+    -o "src/entropy-wasm/build/${output}" \
+    -s WASM=1 \
+    -s EXPORTED_RUNTIME_METHODS='["cwrap", "ccall", "HEAPU8"]' \
+    -s ALLOW_MEMORY_GROWTH=1 \
+    -s MODULARIZE=1 \
+    -s EXPORT_ES6=1 \
+    -s EXPORT_NAME='EntropyModule' \
+    -s ENVIRONMENT='web,worker' \
+    -s USE_ES6_IMPORT_META=0 \
+    -s SINGLE_FILE=0 \
+    -O3 \
+    -s ASSERTIONS=0 \
+    --bind \
+    -s INITIAL_MEMORY="${INITIAL_MEMORY}" \
+    -s MAXIMUM_MEMORY=512MB \
+    -s FAST_UNROLLED_LOOPS=1 \
+    -s AGGRESSIVE_VARIABLE_ELIMINATION=1 \
+    -DENTROPY_ENABLE_STATS="${STATS}" \
+    "$@"
+}
+
+compile_variant entropy.js || { echo "❌ WebAssembly compilation failed!"; exit 1; }
+
+echo "⚡ Compiling SIMD variant..."
+compile_variant entropy-simd.js -msimd128 || { echo "❌ SIMD WebAssembly compilation failed!"; exit 1; }
+
+echo "🖥️ Compiling Node variant for offline tools..."
+compile_variant node/entropy.mjs -msimd128 -s ENVIRONMENT='node' \
+  || { echo "❌ Node WebAssembly compilation failed!"; exit 1; }
+
+echo "✅ WebAssembly compilation successful!"
+echo "📁 Generated files:"
+for file in src/entropy-wasm/build/entropy*.js src/entropy-wasm/build/entropy*.wasm src/entropy-wasm/build/node/*; do
+  echo "   - ${file}"
+done
+
+# Copy files to public directory for web access
+cp src/entropy-wasm/build/entropy*.wasm src/entropy-wasm/build/entropy*.js public/
+echo "   - public/entropy*.{js,wasm} (copied for web access)"
+
+echo "🚀 Ready for ultra-fast entropy calculations!"
@@ -1,10 +1,29 @@
 // High-Performance Entropy Calculation Web Worker
 // Optimized JavaScript implementation for maximum compatibility
+// Fallback for browsers that cannot start the module worker (src/entropyWorker.worker.ts).
+// A classic worker cannot import the ES module WASM builds, so this one always runs JS.
+
+// Scoring slice length; short enough that a cancel or newer request waits under a frame
+const SLICE_MS = 8;
+
+// Yields to the event loop so queued messages (a cancel, a newer request) run between slices
+function yieldToEventLoop() {
+  return new Promise(function(resolve) {
+    const channel = new MessageChannel();
+    channel.port1.onmessage = function() {
+      channel.port1.close();
+      resolve();
+    };
+    channel.port2.postMessage(null);
+  });
+}
 
 class OptimizedEntropyCalculator {
   constructor() {
     this.allWords = [];
     this.possibleAnswers = [];
+    this.shardWords = [];
+    this.priors = null; // per dictionary word, from setPriors
     console.log('🧠 High-Performance Entropy Calculator initialized');
   }
 
@@ -40,23 +59,26 @@ class OptimizedEntropyCalculator {
     return result.join('');
   }
 
-  // Optimized entropy calculation with Map for O(1) lookups
-  calculateEntropy(guessWord, possibleAnswers) {
+  // Optimized entropy calculation with Map for O(1) lookups; weights (parallel to the
+  // answers) gives the prior-weighted entropy
+  calculateEntropy(guessWord, possibleAnswers, weights) {
     if (!possibleAnswers) possibleAnswers = this.possibleAnswers;
     if (possibleAnswers.length <= 1) return 0;
     
     const patternCounts = new Map();
     const upperGuess = guessWord.toUpperCase();
+    let totalAnswers = 0;
     
     // Use for-loop instead of forEach for better performance
     for (let i = 0; i < possibleAnswers.length; i++) {
       const pattern = this.getPattern(upperGuess, possibleAnswers[i]);
-      patternCounts.set(pattern, (patternCounts.get(pattern) || 0) + 1);
+      const weight = weights ? weights[i] : 1;
+      patternCounts.set(pattern, (patternCounts.get(pattern) || 0) + weight);
+      totalAnswers += weight;
     }
     
     // Calculate Shannon entropy with optimized math
     let entropy = 0;
-    const totalAnswers = possibleAnswers.length;
     const log2 = Math.log(2);
     
     // Convert Map values to array for compatibility
@@ -101,65 +123,91 @@ class OptimizedEntropyCalculator {
     return results;
   }
 
-  // High-speed word filtering with early termination
-  filterWords(words, knownPositions, yellowLetters, grayLetters) {
-    const filtered = [];
-    const graySet = new Set();
-    
-    // Convert gray letters to uppercase and add to set
-    for (let i = 0; i < grayLetters.length; i++) {
-      graySet.add(grayLetters[i].toUpperCase());
+  // calculateAllEntropies in SLICE_MS slices, reporting progress after each slice and
+  // checking isCancelled between slices; resolves null when cancelled
+  async calculateAllEntropiesSliced(allWords, possibleAnswers, onProgress, isCancelled, weights) {
+    allWords = allWords || this.allWords;
+    possibleAnswers = possibleAnswers || this.possibleAnswers;
+    if (possibleAnswers.length === 0) return [];
+
+    const results = new Array(allWords.length);
+    let scored = 0;
+    while (scored < allWords.length) {
+      const sliceEnd = performance.now() + SLICE_MS;
+      do {
+        const entropy = this.calculateEntropy(allWords[scored], possibleAnswers, weights);
+        results[scored] = {
+          word: allWords[scored],
+          entropy: entropy,
+          bitsOfInfo: Math.round(entropy * 100) / 100
+        };
+        scored++;
+      } while (scored < allWords.length && performance.now() < sliceEnd);
+
+      onProgress({ scored: scored, total: allWords.length });
+      await yieldToEventLoop();
+      if (isCancelled()) return null;
+    }
+
+    results.sort(function(a, b) { return b.entropy - a.entropy; });
+    return results;
+  }
+
+  // Rows of `words` consistent with the board, with the rules of src/wordFilter.ts (and the
+  // engine): per letter at least max(greens, yellow entries) copies, capped at that minimum by
+  // a gray; greens fixed, yellows excluded from their positions
+  matchingRows(words, knownPositions, yellowLetters, grayLetters) {
+    const minCount = {};
+    const maxCount = {};
+    const excluded = [];
+    const greenCount = {};
+    const yellowCount = {};
+    for (let i = 0; i < knownPositions.length; i++) {
+      const letter = knownPositions[i] ? knownPositions[i].toUpperCase() : '';
+      if (letter) greenCount[letter] = (greenCount[letter] || 0) + 1;
+      excluded.push(new Set());
     }
-    
-    // Pre-process yellow letters for faster lookup
-    const yellowConstraints = [];
     for (let i = 0; i < yellowLetters.length; i++) {
-      const y = yellowLetters[i];
-      yellowConstraints.push({
-        letter: y.letter.toUpperCase(),
-        excludedPositions: y.excludedPositions
-      });
+      const letter = yellowLetters[i].letter.toUpperCase();
+      yellowCount[letter] = (yellowCount[letter] || 0) + 1;
+      const positions = yellowLetters[i].excludedPositions;
+      for (let k = 0; k < positions.length; k++) {
+        if (excluded[positions[k]]) excluded[positions[k]].add(letter);
+      }
     }
-    
+    for (const letter of Object.keys(greenCount).concat(Object.keys(yellowCount))) {
+      minCount[letter] = Math.max(greenCount[letter] || 0, yellowCount[letter] || 0);
+    }
+    for (let i = 0; i < grayLetters.length; i++) {
+      const letter = grayLetters[i].toUpperCase();
+      maxCount[letter] = minCount[letter] || 0;
+    }
+
+    const rows = [];
     wordLoop: for (let i = 0; i < words.length; i++) {
       const word = words[i].toUpperCase();
-      
-      // Check gray letters first (fastest elimination)
+      if (word.length !== knownPositions.length) continue;
+      const counts = {};
       for (let j = 0; j < word.length; j++) {
-        if (graySet.has(word[j])) {
-          continue wordLoop;
-        }
+        const green = knownPositions[j] ? knownPositions[j].toUpperCase() : '';
+        if (green ? word[j] !== green : excluded[j].has(word[j])) continue wordLoop;
+        counts[word[j]] = (counts[word[j]] || 0) + 1;
       }
-      
-      // Check known positions (green letters)
-      for (let j = 0; j < knownPositions.length; j++) {
-        if (knownPositions[j] && word[j] !== knownPositions[j]) {
-          continue wordLoop;
-        }
+      for (const letter in minCount) {
+        if ((counts[letter] || 0) < minCount[letter]) continue wordLoop;
       }
-      
-      // Check yellow letters
-      for (let j = 0; j < yellowConstraints.length; j++) {
-        const yellow = yellowConstraints[j];
-        
-        // Word must contain the letter
-        if (word.indexOf(yellow.letter) === -1) {
-          continue wordLoop;
-        }
-        
-        // Letter must not be in excluded positions
-        for (let k = 0; k < yellow.excludedPositions.length; k++) {
-          const pos = yellow.excludedPositions[k];
-          if (word[pos] === yellow.letter) {
-            continue wordLoop;
-          }
-        }
+      for (const letter in maxCount) {
+        if ((counts[letter] || 0) > maxCount[letter]) continue wordLoop;
       }
-      
-      filtered.push(words[i]); // Keep original case
+      rows.push(i);
     }
-    
-    return filtered;
+    return rows;
+  }
+
+  filterWords(words, knownPositions, yellowLetters, grayLetters) {
+    return this.matchingRows(words, knownPositions, yellowLetters, grayLetters).map(function(row) {
+      return words[row]; // Keep original case
+    });
   }
 
   // Set word lists for calculations
@@ -177,17 +225,141 @@ class OptimizedEntropyCalculator {
     
     console.log('📝 Word lists updated: ' + this.allWords.length + ' total, ' + this.possibleAnswers.length + ' possible');
   }
+
+  // Pool protocol: the whole dictionary (fixed-stride char codes, zero padded) plus the range
+  // of guesses this worker scores. Answers arrive later as indices into the dictionary.
+  setDictionary(bytes, stride, count, shardBegin, shardEnd) {
+    const words = new Array(count);
+    for (let i = 0; i < count; i++) {
+      let word = '';
+      for (let j = 0; j < stride && bytes[i * stride + j] !== 0; j++) {
+        word += String.fromCharCode(bytes[i * stride + j]);
+      }
+      words[i] = word.toUpperCase();
+    }
+    this.allWords = words;
+    this.possibleAnswers = words;
+    this.shardWords = words.slice(shardBegin, shardEnd);
+    this.priors = null;
+    console.log('📝 Dictionary received: ' + count + ' words, scoring ' + shardBegin + '-' + shardEnd);
+  }
+
+  // Answer priors for the current dictionary (a shared or transferred Float32Array), or null
+  setPriors(priors) {
+    this.priors = priors && priors.length === this.allWords.length ? priors : null;
+  }
+
+  // Hard-mode guess rule: greens stay in place and every revealed letter is reused at least as
+  // often as revealed
+  satisfiesHints(word, knownPositions, yellowLetters) {
+    const required = {};
+    for (let i = 0; i < knownPositions.length; i++) {
+      const letter = knownPositions[i] ? knownPositions[i].toUpperCase() : '';
+      if (letter && word[i] !== letter) return false;
+      if (letter) required[letter] = (required[letter] || 0) + 1;
+    }
+    const yellowCount = {};
+    for (let i = 0; i < yellowLetters.length; i++) {
+      const letter = yellowLetters[i].letter.toUpperCase();
+      yellowCount[letter] = (yellowCount[letter] || 0) + 1;
+      required[letter] = Math.max(required[letter] || 0, yellowCount[letter]);
+    }
+    const counts = {};
+    for (let i = 0; i < word.length; i++) counts[word[i]] = (counts[word[i]] || 0) + 1;
+    for (const letter in required) {
+      if ((counts[letter] || 0) < required[letter]) return false;
+    }
+    return true;
+  }
+
+  // This worker's shard ranked against the given answers; the best topK when topK > 0.
+  // With `board` ({ constraints, hardMode }) the answers are the dictionary words it allows.
+  async calculateShard(answerIndices, answers, topK, onProgress, isCancelled, board) {
+    let possibleAnswers;
+    let weights = null;
+    let guesses = this.shardWords;
+    if (board) {
+      const c = board.constraints;
+      answerIndices = Uint32Array.from(this.matchingRows(this.allWords, c.knownPositions, c.yellowLetters, c.grayLetters));
+      if (board.hardMode) {
+        const self = this;
+        guesses = guesses.filter(function(guess) {
+          return self.satisfiesHints(guess, c.knownPositions, c.yellowLetters);
+        });
+      }
+    }
+    if (answerIndices) {
+      possibleAnswers = new Array(answerIndices.length);
+      if (this.priors) weights = new Float32Array(answerIndices.length);
+      for (let i = 0; i < answerIndices.length; i++) {
+        possibleAnswers[i] = this.allWords[answerIndices[i]];
+        if (weights) weights[i] = this.priors[answerIndices[i]];
+      }
+    } else {
+      possibleAnswers = [];
+      const source = answers || this.possibleAnswers;
+      for (let i = 0; i < source.length; i++) {
+        possibleAnswers.push(source[i].toUpperCase());
+      }
+    }
+    const results = await this.calculateAllEntropiesSliced(guesses, possibleAnswers, onProgress, isCancelled, weights);
+    return results && topK > 0 ? results.slice(0, topK) : results;
+  }
 }
 
 // Global calculator instance
 const calculator = new OptimizedEntropyCalculator();
 
+// The running bulk calculation; a newer one supersedes it, and 'cancel' abandons it
+let activeJob = null;
+
+async function runSlicedCalculation(requestId, compute) {
+  if (activeJob) activeJob.cancelled = true;
+  const job = { requestId: requestId, cancelled: false };
+  activeJob = job;
+
+  try {
+    const result = await compute(
+      function(progress) { postMessage({ type: 'progress', requestId: requestId, progress: progress }); },
+      function() { return job.cancelled; }
+    );
+    if (result) {
+      postMessage({ type: 'success', requestId: requestId, result: result });
+    } else {
+      postMessage({ type: 'cancelled', requestId: requestId });
+    }
+  } catch (error) {
+    console.error('❌ Worker error:', error);
+    postMessage({ type: 'error', requestId: requestId, error: error.message });
+  } finally {
+    if (activeJob === job) activeJob = null;
+  }
+}
+
 // Web Worker message handler - using traditional function declaration for compatibility
 onmessage = function(e) {
   const messageData = e.data;
   const type = messageData.type;
   const data = messageData.data;
   const requestId = messageData.requestId;
+
+  if (type === 'calculateAllEntropies') {
+    runSlicedCalculation(requestId, function(onProgress, isCancelled) {
+      return calculator.calculateAllEntropiesSliced(data.allWords, data.possibleAnswers, onProgress, isCancelled);
+    });
+    return;
+  }
+  if (type === 'calculateShard') {
+    runSlicedCalculation(requestId, function(onProgress, isCancelled) {
+      const board = data.constraints ? { constraints: data.constraints, hardMode: !!data.hardMode } : null;
+      return calculator.calculateShard(data.answerIndices, data.answers, data.topK, onProgress, isCancelled, board);
+    });
+    return;
+  }
+  if (type === 'cancel') {
+    if (activeJob && activeJob.requestId === data.requestId) activeJob.cancelled = true;
+    return;
+  }
   
   try {
     let result;
@@ -195,10 +367,19 @@ onmessage = function(e) {
     if (type === 'setWordLists') {
       calculator.setWordLists(data.allWords, data.possibleAnswers);
       result = { success: true };
+    } else if (type === 'setDictionary') {
+      calculator.setDictionary(data.bytes, data.stride, data.count, data.shardBegin, data.shardEnd);
+      result = { success: true };
+    } else if (type === 'setPriors') {
+      calculator.setPriors(data.priors);
+      result = { success: true };
     } else if (type === 'calculateEntropy') {
       result = calculator.calculateEntropy(data.word, data.possibleAnswers);
-    } else if (type === 'calculateAllEntropies') {
-      result = calculator.calculateAllEntropies(data.allWords, data.possibleAnswers);
+    } else if (type === 'getStats') {
+      result = null; // no engine counters in the JS-only worker
+    } else if (type === 'filterDictionary') {
+      const c = data.constraints;
+      result = Uint32Array.from(calculator.matchingRows(calculator.possibleAnswers, c.knownPositions, c.yellowLetters, c.grayLetters));
     } else if (type === 'filterWords') {
       result = calculator.filterWords(
         data.words, 
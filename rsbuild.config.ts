@@ -29,6 +29,11 @@ export default defineConfig({
   server: {
     port: 3000,
     open: true,
+    // Cross-origin isolation enables SharedArrayBuffer, so the worker pool shares one dictionary buffer
+    headers: {
+      'Cross-Origin-Opener-Policy': 'same-origin',
+      'Cross-Origin-Embedder-Policy': 'require-corp',
+    },
   },
   dev: {
     // Enable fast refresh for React
@@ -0,0 +1,67 @@
+#!/usr/bin/env node
+// Builds public/openings_N_letters.bin opening books with the Node build of the C++ engine
+//
+// Requires ./compile-wasm.sh (for src/entropy-wasm/build/node/entropy.mjs) and
+// npm run pack-dictionaries. Pass word lengths to limit the run, e.g.
+//   node scripts/build-opening-tables.mjs 4 5 6
+//
+// The table layout is documented next to EntropyCalculator::buildOpeningTable.
+
+import fs from 'fs';
+import path from 'path';
+import { fileURLToPath } from 'url';
+
+const ROOT_DIR = path.join(path.dirname(fileURLToPath(import.meta.url)), '..');
+const PUBLIC_DIR = path.join(ROOT_DIR, 'public');
+const ENGINE = path.join(ROOT_DIR, 'src', 'entropy-wasm', 'build', 'node', 'entropy.mjs');
+
+// Openers listed in the UI, and how many of them get second-move tables
+const OPENER_COUNT = 12;
+const FOLLOW_UP_OPENERS = 1;
+
+if (!fs.existsSync(ENGINE)) {
+  console.error('❌ Node engine build not found, run ./compile-wasm.sh first');
+  process.exit(1);
+}
+
+const { default: EntropyModule } = await import(ENGINE);
+const engine = await EntropyModule();
+const calculator = new engine.EntropyCalculator();
+
+const available = fs
+  .readdirSync(PUBLIC_DIR)
+  .map((file) => file.match(/^words_(\d+)_letters\.bin$/))
+  .filter(Boolean)
+  .map((match) => Number(match[1]))
+  .sort((a, b) => a - b);
+const requested = process.argv.slice(2).map(Number);
+const lengths = requested.length > 0 ? available.filter((length) => requested.includes(length)) : available;
+
+if (lengths.length === 0) {
+  console.error('❌ No packed dictionaries found, run npm run pack-dictionaries first');
+  process.exit(1);
+}
+
+for (const length of lengths) {
+  const startTime = performance.now();
+  const dictionary = fs.readFileSync(path.join(PUBLIC_DIR, `words_${length}_letters.bin`));
+
+  const pointer = calculator.allocateBuffer(dictionary.length);
+  engine.HEAPU8.set(dictionary, pointer);
+  const wordCount = calculator.setDictionaryBinary(pointer, dictionary.length);
+  calculator.freeBuffer(pointer);
+  if (wordCount < 0) {
+    console.warn(`⚠️ Skipping ${length}-letter dictionary: invalid header`);
+    continue;
+  }
+
+  calculator.buildOpeningTable(OPENER_COUNT, FOLLOW_UP_OPENERS);
+  const table = calculator.getOpeningTable().slice();
+  fs.writeFileSync(path.join(PUBLIC_DIR, `openings_${length}_letters.bin`), table);
+
+  const seconds = ((performance.now() - startTime) / 1000).toFixed(1);
+  console.log(`📖 ${length} letters: ${wordCount} words → ${table.length} bytes in ${seconds}s`);
+}
+
+calculator.delete();
+console.log('✅ Opening tables written to public/');
@@ -0,0 +1,68 @@
+#!/usr/bin/env node
+// Packs public/words_N_letters.json into public/words_N_letters.bin
+//
+// Layout (little endian):
+//   0  "WDLB" magic
+//   4  u8  format version (1)
+//   5  u8  word length
+//   6  u8  bits per letter (5)
+//   7  u8  reserved
+//   8  u32 word count
+//   12 u32 bytes per word = ceil(length * 5 / 8)
+//   16 rows: letter slots A-Z = 0-25, any other character = 26, packed LSB first
+//
+// Decoded by src/dictionaryFormat.ts and EntropyCalculator::setDictionaryBinary.
+
+const fs = require('fs');
+const path = require('path');
+
+const PUBLIC_DIR = path.join(__dirname, '..', 'public');
+const HEADER_BYTES = 16;
+const VERSION = 1;
+const LETTER_BITS = 5;
+
+const letterSlot = (char) => {
+  const index = char.toUpperCase().charCodeAt(0) - 65;
+  return index >= 0 && index < 26 ? index : 26;
+};
+
+const packWords = (words, wordLength) => {
+  const stride = Math.ceil((wordLength * LETTER_BITS) / 8);
+  const buffer = Buffer.alloc(HEADER_BYTES + words.length * stride);
+  buffer.write('WDLB', 0, 'latin1');
+  buffer.writeUInt8(VERSION, 4);
+  buffer.writeUInt8(wordLength, 5);
+  buffer.writeUInt8(LETTER_BITS, 6);
+  buffer.writeUInt32LE(words.length, 8);
+  buffer.writeUInt32LE(stride, 12);
+
+  words.forEach((word, i) => {
+    const offset = HEADER_BYTES + i * stride;
+    for (let p = 0; p < wordLength; p++) {
+      const bit = p * LETTER_BITS;
+      const value = letterSlot(word[p]) << (bit & 7);
+      buffer[offset + (bit >> 3)] |= value & 0xff;
+      if (value > 0xff) buffer[offset + (bit >> 3) + 1] |= value >> 8;
+    }
+  });
+  return buffer;
+};
+
+const files = fs.readdirSync(PUBLIC_DIR).filter((file) => /^words_\d+_letters\.json$/.test(file));
+let jsonBytes = 0;
+let binaryBytes = 0;
+
+for (const file of files) {
+  const wordLength = Number(file.match(/^words_(\d+)_letters\.json$/)[1]);
+  const source = fs.readFileSync(path.join(PUBLIC_DIR, file));
+  const words = JSON.parse(source.toString('utf8')).filter((word) => word.length === wordLength);
+  const packed = packWords(words, wordLength);
+  fs.writeFileSync(path.join(PUBLIC_DIR, file.replace(/\.json$/, '.bin')), packed);
+  jsonBytes += source.length;
+  binaryBytes += packed.length;
+}
+
+console.log(
+  `📦 Packed ${files.length} dictionaries: ${(jsonBytes / 1024).toFixed(0)}KB JSON → ` +
+    `${(binaryBytes / 1024).toFixed(0)}KB binary`
+);
@@ -1,14 +1,56 @@
 import React, { useState, useMemo, useCallback, useEffect } from 'react';
 import { DndProvider, useDrag, useDrop } from 'react-dnd';
 import { HTML5Backend } from 'react-dnd-html5-backend';
-import { getBestStartingWords } from './bestStartingWords';
-import { entropyWorker, EntropyResult } from './entropyWorker';
+import { getBestStartingWords, startingWordsFromOpenings } from './bestStartingWords';
+import { entropyWorker, EntropyResult, EntropyProgress, EntropyReadiness } from './entropyWorker';
+import { decodeDictionary } from './dictionaryFormat';
+import { bookSecondMove, loadOpeningTable, OpeningTable } from './openingTable';
+import { filterWords } from './wordFilter';
 import './App.css';
 
 // Consolidated word loading system - single cache layer with performance optimizations
 const wordCache = new Map<number, string[]>();
 const loadingStates = new Map<number, Promise<string[]>>();
 
+const fetchDictionary = (length: number, extension: 'bin' | 'json'): Promise<Response> =>
+  fetch(`/words_${length}_letters.${extension}`, {
+    headers: {
+      'Accept-Encoding': 'gzip, deflate, br', // Request compression
+      'Cache-Control': 'max-age=3600' // Cache for 1 hour
+    },
+    // Add timeout to prevent hanging
+    signal: AbortSignal.timeout(30000) // 30 second timeout
+  });
+
+// Binary dictionary from scripts/pack-dictionaries.js; null when missing or invalid
+const fetchBinaryWords = async (length: number): Promise<string[] | null> => {
+  try {
+    const response = await fetchDictionary(length, 'bin');
+    if (!response.ok) return null;
+    const decodeStart = performance.now();
+    const words = decodeDictionary(await response.arrayBuffer());
+    if (words && words.length > 0 && words[0].length !== length) return null;
+    if (words) console.log(`📦 Binary decode completed in ${(performance.now() - decodeStart).toFixed(2)}ms`);
+    return words;
+  } catch (error) {
+    console.warn(`⚠️ Binary ${length}-letter dictionary unavailable, falling back to JSON:`, error);
+    return null;
+  }
+};
+
+const fetchJsonWords = async (length: number): Promise<string[]> => {
+  const response = await fetchDictionary(length, 'json');
+  if (!response.ok) {
+    throw new Error(`Failed to load ${length}-letter words: ${response.statusText}`);
+  }
+  
+  // Parse JSON with performance measurement
+  const parseStart = performance.now();
+  const words: string[] = await response.json();
+  console.log(`📊 JSON parse completed in ${(performance.now() - parseStart).toFixed(2)}ms`);
+  return words;
+};
+
 const loadWordsForLength = async (length: number): Promise<string[]> => {
   // Return cached words if available
   if (wordCache.has(length)) {
@@ -28,31 +70,12 @@ const loadWordsForLength = async (length: number): Promise<string[]> => {
       console.log(`🔄 Loading ${length}-letter words with optimizations...`);
       const startTime = performance.now();
       
-      // Fetch with compression and timeout optimizations
-      const response = await fetch(`/words_${length}_letters.json`, {
-        headers: {
-          'Accept-Encoding': 'gzip, deflate, br', // Request compression
-          'Cache-Control': 'max-age=3600' // Cache for 1 hour
-        },
-        // Add timeout to prevent hanging
-        signal: AbortSignal.timeout(30000) // 30 second timeout
-      });
-      
-      if (!response.ok) {
-        throw new Error(`Failed to load ${length}-letter words: ${response.statusText}`);
-      }
+      // Packed binary dictionary first: no JSON parse, roughly 2.5x smaller download
+      const words = await fetchBinaryWords(length) ?? await fetchJsonWords(length);
+      const totalTime = performance.now() - startTime;
       
-      const fetchTime = performance.now() - startTime;
-      console.log(`📡 Fetch completed in ${fetchTime.toFixed(2)}ms`);
-      
-      // Parse JSON with performance measurement
-      const parseStart = performance.now();
-      const words: string[] = await response.json();
-      const parseTime = performance.now() - parseStart;
-      
-      console.log(`📊 JSON parse completed in ${parseTime.toFixed(2)}ms`);
-      console.log(`📋 Total loading time: ${(fetchTime + parseTime).toFixed(2)}ms for ${words.length} words`);
-      console.log(`🚀 Average: ${((fetchTime + parseTime) / words.length).toFixed(4)}ms per word`);
+      console.log(`📋 Total loading time: ${totalTime.toFixed(2)}ms for ${words.length} words`);
+      console.log(`🚀 Average: ${(totalTime / words.length).toFixed(4)}ms per word`);
       
       wordCache.set(length, words);
       loadingStates.delete(length); // Clean up loading state
@@ -69,49 +92,15 @@ const loadWordsForLength = async (length: number): Promise<string[]> => {
   return loadPromise;
 };
 
-// Optimized word filtering - will be moved to WebAssembly worker
-const filterWords = (
-  words: string[],
-  knownPositions: string[],
-  yellowLetters: Array<{ letter: string; excludedPositions: number[] }>,
-  grayLetters: string[]
-): string[] => {
-  return words.filter(word => {
-    const upperWord = word.toUpperCase();
-
-    // Check if word matches known positions (green letters)
-    for (let i = 0; i < knownPositions.length; i++) {
-      if (knownPositions[i] && upperWord[i] !== knownPositions[i]) {
-        return false;
-      }
-    }
-
-    // Check if word contains yellow letters but not in excluded positions
-    for (const { letter, excludedPositions } of yellowLetters) {
-      const upperLetter = letter.toUpperCase();
-
-      // Word must contain the letter
-      if (!upperWord.includes(upperLetter)) {
-        return false;
-      }
-
-      // Letter must not be in any of the excluded positions
-      for (const position of excludedPositions) {
-        if (upperWord[position] === upperLetter) {
-          return false;
-        }
-      }
-    }
-
-    // Check if word contains any gray letters
-    for (const grayLetter of grayLetters) {
-      if (upperWord.includes(grayLetter.toUpperCase())) {
-        return false;
-      }
-    }
-
-    return true;
-  });
+// Runs `task` once the browser is idle (after first paint and input), or after `timeout` ms.
+// Returns a cancel function.
+const whenIdle = (task: () => void, timeout = 1500): (() => void) => {
+  if (typeof window.requestIdleCallback === 'function') {
+    const handle = window.requestIdleCallback(task, { timeout });
+    return () => window.cancelIdleCallback(handle);
+  }
+  const handle = setTimeout(task, 200); // Safari has no idle callbacks
+  return () => clearTimeout(handle);
 };
 
 const ITEM_TYPE = 'LETTER';
@@ -188,10 +177,16 @@ function App() {
   const [knownPositions, setKnownPositions] = useState<string[]>(new Array(wordLength).fill(''));
   const [yellowLetters, setYellowLetters] = useState<Array<{ letter: string, excludedPositions: number[] }>>([]);
   const [grayLetters, setGrayLetters] = useState<string[]>([]);
+  const [hardMode, setHardMode] = useState(false); // suggest only guesses that reuse every hint
 
   // New state for Web Worker integration
   const [entropyResults, setEntropyResults] = useState<EntropyResult[]>([]);
   const [isCalculatingEntropy, setIsCalculatingEntropy] = useState(false);
+  const [entropyProgress, setEntropyProgress] = useState<EntropyProgress | null>(null);
+  const [openingTable, setOpeningTable] = useState<OpeningTable | null>(null);
+  const [engineReadiness, setEngineReadiness] = useState<EntropyReadiness>(entropyWorker.getReadiness());
+
+  useEffect(() => entropyWorker.onReadiness(setEngineReadiness), []);
 
 
 
@@ -203,6 +198,8 @@ function App() {
 
   // Load words when word length changes - now truly async and non-blocking
   useEffect(() => {
+    let cancelled = false;
+    let cancelEngineStart = () => {};
     const loadWords = async () => {
       setWordsLoadingStatus(`Loading ${wordLength}-letter words...`);
       console.log(`🔄 Background loading ${wordLength}-letter words...`);
@@ -210,13 +207,18 @@ function App() {
       try {
         // Start loading words in background - UI remains interactive
         const newWords = await loadWordsForLength(wordLength);
+        if (cancelled) return;
         console.log(`✅ Background loaded ${newWords.length} words of length ${wordLength}`);
         setWords(newWords);
         setWordsLoadingStatus('');
 
-        // Initialize worker with word list for entropy calculations (when needed)
+        // Filtering and the starting words only need the list; the worker pool and its
+        // engine start once the page is idle (a ranking asked for sooner starts them itself)
         if (newWords.length > 0) {
-          await entropyWorker.setWordLists(newWords, newWords);
+          cancelEngineStart = whenIdle(() => {
+            entropyWorker.setWordLists(newWords, newWords).catch(error =>
+              console.error('❌ Error preparing entropy engine:', error));
+          });
         }
 
       } catch (error) {
@@ -228,20 +230,56 @@ function App() {
 
     loadWords();
     setKnownPositions(new Array(wordLength).fill(''));
-  }, [wordLength]);  // Removed showLoading, hideLoading - no blocking UI  // Simple word filtering - instant results
-  const filteredWords = useMemo(() => {
+
+    // Engine-ranked openers replace the hand-picked list once the opening table arrives
+    setOpeningTable(null);
+    loadOpeningTable(wordLength).then(table => {
+      if (!cancelled) setOpeningTable(table);
+    });
+    return () => {
+      cancelled = true;
+      cancelEngineStart();
+    };
+  }, [wordLength]);  // Removed showLoading, hideLoading - no blocking UI
+
+  // Matching words: filtered by the workers' engine once the pool is ready, and by the JS
+  // filter (same rules) until then or if the pool fails
+  const [filteredWords, setFilteredWords] = useState<string[]>([]);
+  const engineStage = engineReadiness.stage;
+  useEffect(() => {
     console.log(`🔍 Filtering ${words.length} words with constraints:`, {
       knownPositions: knownPositions.map((pos, i) => pos ? `${i + 1}:${pos}` : null).filter(Boolean),
       yellowLetters: yellowLetters.map(y => `${y.letter}(not in ${y.excludedPositions.map(p => p + 1).join(',')})`),
       grayLetters
     });
-    const result = filterWords(words, knownPositions, yellowLetters, grayLetters);
-    console.log(`✅ Found ${result.length} matching words:`, result.slice(0, 5));
-    return result;
-  }, [words, knownPositions, yellowLetters, grayLetters]);
+    const filterLocally = () => filterWords(words, { knownPositions, yellowLetters, grayLetters });
+    const show = (result: string[]) => {
+      console.log(`✅ Found ${result.length} matching words:`, result.slice(0, 5));
+      setFilteredWords(result);
+    };
+    if (engineStage !== 'ready' || words.length === 0) {
+      show(filterLocally());
+      return;
+    }
+
+    let stale = false;
+    entropyWorker.filterWords(words, knownPositions, yellowLetters, grayLetters).then(
+      result => { if (!stale) show(result); },
+      error => {
+        console.warn('⚠️ Engine filtering failed, filtering in JS:', error);
+        if (!stale) show(filterLocally());
+      }
+    );
+    return () => {
+      stale = true;
+    };
+  }, [words, knownPositions, yellowLetters, grayLetters, engineStage]);
 
   // Calculate entropy-sorted suggestions using Web Worker - ONLY when user has constraints
   useEffect(() => {
+    // Aborted when the constraints change, so a superseded calculation stops at its next slice
+    const controller = new AbortController();
+
     const calculateEntropyAsync = async () => {
       // Only calculate if we have constraints (user has started guessing)
       const hasConstraints = knownPositions.some(pos => pos !== '') ||
@@ -256,7 +294,9 @@ function App() {
         return;
       }
 
-      if (words.length === 0 || filteredWords.length === 0) {
+      // The engine narrows the answers from the board itself; a board no word matches comes
+      // back as an empty ranking, so only a missing dictionary is handled here
+      if (words.length === 0) {
         setEntropyResults([]);
         setIsCalculatingEntropy(false);
         return;
@@ -264,35 +304,42 @@ function App() {
 
       try {
         setIsCalculatingEntropy(true);
+        setEntropyProgress(null);
         console.log('🚀 Starting BACKGROUND Web Worker entropy calculation (user has constraints)');
 
-        // Use filtered words as possible answers and calculate entropy for all words
-        const possibleAnswers = filteredWords.length > 0 ? filteredWords : words;
-        
-        // Send word lists to worker
-        await entropyWorker.setWordLists(words, possibleAnswers);
-        
-        // Calculate entropy for all words
-        const results = await entropyWorker.calculateAllEntropies(words, possibleAnswers);
+        // The pool already holds the dictionary; only the board travels, and each worker's
+        // engine narrows its answers to the filtered words in place (hard mode also limits
+        // the guesses). Each worker returns its shard's top 20 and the manager merges them.
+        const results = await entropyWorker.calculateAllEntropies(words, undefined, {
+          onProgress: setEntropyProgress,
+          signal: controller.signal,
+          topK: 20,
+          constraints: { knownPositions, yellowLetters, grayLetters },
+          hardMode,
+        });
         
-        // Take top 20 results
-        setEntropyResults(results.slice(0, 20));
+        setEntropyResults(results);
         
         console.log('✅ BACKGROUND Web Worker entropy calculation completed:', results.length, 'results');
         
       } catch (error) {
+        // A newer constraint state took over; its calculation owns the indicator now
+        if (controller.signal.aborted) return;
         console.error('❌ Error in Web Worker entropy calculation:', error);
         setEntropyResults([]);
-      } finally {
-        setIsCalculatingEntropy(false);
       }
+      setIsCalculatingEntropy(false);
+      setEntropyProgress(null);
     };
 
     // Debounce calculations to avoid excessive computation
     const timeoutId = setTimeout(calculateEntropyAsync, 300);
     
-    return () => clearTimeout(timeoutId);
-  }, [words, filteredWords, knownPositions, yellowLetters, grayLetters]);
+    return () => {
+      clearTimeout(timeoutId);
+      controller.abort();
+    };
+  }, [words, knownPositions, yellowLetters, grayLetters, hardMode]);
 
   // Simple game state
   const isGameWon = filteredWords.length === 1;
@@ -310,8 +357,17 @@ function App() {
 
     // Get pre-computed starting words for current word length
     console.log(`🎯 Showing pre-computed starting words for ${wordLength}-letter words`);
+    if (openingTable && openingTable.openers.length > 0) {
+      return startingWordsFromOpenings(openingTable.openers);
+    }
     return getBestStartingWords(wordLength);
-  }, [wordLength, knownPositions, yellowLetters, grayLetters]);
+  }, [wordLength, knownPositions, yellowLetters, grayLetters, openingTable]);
+
+  // Precomputed reply when the board is exactly one book opener's feedback
+  const bookMove = useMemo(
+    () => openingTable ? bookSecondMove(openingTable, knownPositions, yellowLetters, grayLetters) : null,
+    [openingTable, knownPositions, yellowLetters, grayLetters]
+  );
 
   // Enhanced animation helpers for interaction-based animations
   const triggerLetterAnimation = (letterKey: string) => {
@@ -419,6 +475,14 @@ function App() {
             </div>
           )}
 
+          {/* Engine Readiness - filtering works meanwhile, rankings wait for it */}
+          {!wordsLoadingStatus && engineReadiness.stage === 'loading' && (
+            <div className="fixed top-20 left-1/2 transform -translate-x-1/2 z-40 backdrop-blur-xl bg-gradient-to-r from-blue-500/20 via-indigo-500/20 to-purple-500/20 border border-blue-400/30 rounded-2xl px-4 py-2 flex items-center space-x-2 shadow-xl animate-fadeIn">
+              <div className="w-4 h-4 border-2 border-blue-400/30 border-t-blue-400 rounded-full animate-spin"></div>
+              <span className="text-blue-200 text-sm font-medium">Preparing entropy engine ({engineReadiness.words} words)...</span>
+            </div>
+          )}
+
           {/* Calculating Indicator at Top */}
           {isCalculating && (
             <div className="fixed top-4 left-1/2 transform -translate-x-1/2 z-50 backdrop-blur-xl bg-gradient-to-r from-purple-500/20 via-pink-500/20 to-indigo-500/20 border border-purple-400/30 rounded-2xl px-6 py-3 flex items-center space-x-3 shadow-2xl animate-fadeIn">
@@ -488,6 +552,16 @@ function App() {
                     </div>
                   </div>
                 </div>
+
+                <label className="flex items-center mt-3 text-sm font-semibold text-indigo-200 cursor-pointer select-none">
+                  <input
+                    type="checkbox"
+                    checked={hardMode}
+                    onChange={(e) => setHardMode(e.target.checked)}
+                    className="mr-2 w-4 h-4 accent-purple-400 cursor-pointer"
+                  />
+                  Hard mode
+                </label>
               </div>
             </div>
           </div>
@@ -697,6 +771,13 @@ function App() {
                 <p className="text-violet-200 text-lg leading-relaxed max-w-3xl mx-auto">
                   Words ranked by information theory - higher bits = better choice
                 </p>
+                {bookMove && (
+                  <p className="text-fuchsia-200 text-sm mt-2">
+                    📖 Book second guess after {bookMove.opener} ({bookMove.pattern}):{' '}
+                    <span className="font-mono font-black tracking-wider">{bookMove.word}</span>{' '}
+                    ({bookMove.entropy.toFixed(2)} bits, {bookMove.remaining} answers left)
+                  </p>
+                )}
               </div>
               {entropyResults.length > 0 ? (
                 <div className="grid grid-cols-2 md:grid-cols-3 lg:grid-cols-4 xl:grid-cols-5 gap-4">
@@ -851,7 +932,11 @@ function App() {
                   {isCalculatingEntropy ? 'Entropy Analysis' : 'Word Filtering'}
                 </span>
                 <span className="text-purple-300/80 text-xs">
-                  {isCalculatingEntropy ? `Analyzing ${words.length} words` : `Processing ${filteredWords.length} matches`}
+                  {isCalculatingEntropy
+                    ? entropyProgress
+                      ? `Scored ${entropyProgress.scored}/${entropyProgress.total} words`
+                      : `Analyzing ${words.length} words`
+                    : `Processing ${filteredWords.length} matches`}
                 </span>
               </div>
             </div>
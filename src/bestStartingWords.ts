@@ -4,6 +4,8 @@
  * Based on information theory analysis and real Wordle research
  */
 
+import { OpeningMove } from './openingTable';
+
 export interface StartingWord {
   word: string;
   entropy?: number;
@@ -113,4 +115,16 @@ export function getBestStartingWords(length: number = 5): StartingWord[] {
  */
 export function hasStartingWords(length: number): boolean {
   return length in BEST_STARTING_WORDS;
-}
\ No newline at end of file
+}
+
+/**
+ * Convert engine-ranked openers from an opening table (see openingTable.ts)
+ * into starting word suggestions
+ */
+export function startingWordsFromOpenings(openers: OpeningMove[]): StartingWord[] {
+  return openers.map((opener, index) => ({
+    word: opener.word,
+    entropy: Math.round(opener.entropy * 100) / 100,
+    description: index === 0 ? "Highest entropy (engine ranked)" : "Engine ranked"
+  }));
+}
@@ -0,0 +1,56 @@
+// Decoder for the binary dictionaries written by scripts/pack-dictionaries.js
+// Rows are fixed-stride 5-bit letter slots (A-Z = 0-25, 26 = '-') behind a 16-byte header.
+
+export const DICTIONARY_HEADER_BYTES = 16;
+const DICTIONARY_VERSION = 1;
+const DICTIONARY_LETTER_BITS = 5;
+const SLOT_CHARS = 'ABCDEFGHIJKLMNOPQRSTUVWXYZ-';
+
+export interface DictionaryHeader {
+  wordLength: number;
+  count: number;
+  stride: number;
+}
+
+// Validates the 16-byte header on its own, before any rows are read
+function parseDictionaryHeader(bytes: Uint8Array): DictionaryHeader | null {
+  if (bytes.length < DICTIONARY_HEADER_BYTES) return null;
+  const view = new DataView(bytes.buffer, bytes.byteOffset, DICTIONARY_HEADER_BYTES);
+  const magic = String.fromCharCode(bytes[0], bytes[1], bytes[2], bytes[3]);
+  if (magic !== 'WDLB' || bytes[4] !== DICTIONARY_VERSION || bytes[6] !== DICTIONARY_LETTER_BITS) {
+    return null;
+  }
+  const wordLength = bytes[5];
+  const count = view.getUint32(8, true);
+  const stride = view.getUint32(12, true);
+  if (wordLength === 0 || stride !== Math.ceil((wordLength * DICTIONARY_LETTER_BITS) / 8)) return null;
+  return { wordLength, count, stride };
+}
+
+// Returns null when the buffer is not a complete dictionary of this format version
+export function readDictionaryHeader(buffer: ArrayBuffer): DictionaryHeader | null {
+  const header = parseDictionaryHeader(new Uint8Array(buffer));
+  if (!header || DICTIONARY_HEADER_BYTES + header.count * header.stride > buffer.byteLength) return null;
+  return header;
+}
+
+export function decodeDictionary(buffer: ArrayBuffer): string[] | null {
+  const header = readDictionaryHeader(buffer);
+  if (!header) return null;
+
+  const { wordLength, count, stride } = header;
+  const bytes = new Uint8Array(buffer, DICTIONARY_HEADER_BYTES, count * stride);
+  const words = new Array<string>(count);
+  const chars = new Array<string>(wordLength);
+  for (let i = 0; i < count; i++) {
+    const offset = i * stride;
+    for (let p = 0; p < wordLength; p++) {
+      const bit = p * DICTIONARY_LETTER_BITS;
+      const byte = offset + (bit >> 3);
+      const window = bytes[byte] | ((bit & 7) > 3 ? bytes[byte + 1] << 8 : 0);
+      chars[p] = SLOT_CHARS[Math.min((window >> (bit & 7)) & 31, 26)];
+    }
+    words[i] = chars.join('');
+  }
+  return words;
+}
@@ -0,0 +1,121 @@
+// Engine snapshots (EntropyCalculator::serializeState) kept between visits, so a warm start
+// restores the packed word lists and answer priors instead of rebuilding them. A snapshot also
+// carries the pattern matrix and opening table when the engine holds them; the pool workers
+// run without either, so theirs are lists and priors only. Entries live in the origin private
+// file system when the browser has one and in IndexedDB otherwise; each slot holds one
+// snapshot plus the key it was built for, so a changed dictionary or prior set overwrites the
+// stale entry.
+
+const DIRECTORY_NAME = 'engine-state';
+const DATABASE_NAME = 'wordle-engine-state';
+const STORE_NAME = 'snapshots';
+
+// Writable OPFS streams are newer than the DOM typings in use here
+interface WritableFileHandle {
+  createWritable?(): Promise<{ write(data: Uint8Array): Promise<void>; close(): Promise<void> }>;
+}
+
+interface StoredSnapshot {
+  key: string;
+  state: Uint8Array;
+}
+
+// FNV-1a over the bytes, as hex; cheap enough to key a whole dictionary
+export function hashStateBytes(bytes: ArrayLike<number>): string {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < bytes.length; i++) {
+    hash = Math.imul(hash ^ bytes[i], 0x01000193);
+  }
+  return (hash >>> 0).toString(16).padStart(8, '0');
+}
+
+async function stateDirectory(): Promise<FileSystemDirectoryHandle | null> {
+  try {
+    if (typeof navigator === 'undefined' || !navigator.storage?.getDirectory) return null;
+    const root = await navigator.storage.getDirectory();
+    return await root.getDirectoryHandle(DIRECTORY_NAME, { create: true });
+  } catch {
+    return null;
+  }
+}
+
+let database: Promise<IDBDatabase | null> | null = null;
+
+function openDatabase(): Promise<IDBDatabase | null> {
+  if (!database) {
+    database = new Promise(resolve => {
+      if (typeof indexedDB === 'undefined') return resolve(null);
+      const request = indexedDB.open(DATABASE_NAME, 1);
+      request.onupgradeneeded = () => request.result.createObjectStore(STORE_NAME);
+      request.onsuccess = () => resolve(request.result);
+      request.onerror = () => resolve(null);
+    });
+  }
+  return database;
+}
+
+function storeRequest<T>(mode: IDBTransactionMode, run: (store: IDBObjectStore) => IDBRequest<T>): Promise<T | null> {
+  return openDatabase().then(db => new Promise<T | null>(resolve => {
+    if (!db) return resolve(null);
+    const request = run(db.transaction(STORE_NAME, mode).objectStore(STORE_NAME));
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => resolve(null);
+  }));
+}
+
+// OPFS files hold a u32 key length, the UTF-8 key, then the snapshot
+function encodeFile(key: string, state: Uint8Array): Uint8Array {
+  const keyBytes = new TextEncoder().encode(key);
+  const file = new Uint8Array(4 + keyBytes.length + state.length);
+  new DataView(file.buffer).setUint32(0, keyBytes.length, true);
+  file.set(keyBytes, 4);
+  file.set(state, 4 + keyBytes.length);
+  return file;
+}
+
+function decodeFile(file: Uint8Array): StoredSnapshot | null {
+  if (file.length < 4) return null;
+  const keyLength = new DataView(file.buffer, file.byteOffset).getUint32(0, true);
+  if (4 + keyLength > file.length) return null;
+  return {
+    key: new TextDecoder().decode(file.subarray(4, 4 + keyLength)),
+    state: file.subarray(4 + keyLength),
+  };
+}
+
+// The snapshot stored in `slot` when it was written for `key`, else null
+export async function readEngineState(slot: string, key: string): Promise<Uint8Array | null> {
+  let stored: StoredSnapshot | null = null;
+  try {
+    const directory = await stateDirectory();
+    if (directory) {
+      const handle = await directory.getFileHandle(`${slot}.bin`).catch(() => null);
+      if (handle) stored = decodeFile(new Uint8Array(await (await handle.getFile()).arrayBuffer()));
+    }
+    // Browsers with OPFS but no writable streams keep their snapshots in IndexedDB
+    if (!stored) stored = await storeRequest<StoredSnapshot>('readonly', store => store.get(slot));
+  } catch (error) {
+    console.warn(`⚠️ Could not read cached engine state ${slot}:`, error);
+    return null;
+  }
+  return stored && stored.key === key ? stored.state : null;
+}
+
+// Replaces the snapshot in `slot`; failures (quota, private browsing) only cost the warm start
+export async function writeEngineState(slot: string, key: string, state: Uint8Array): Promise<void> {
+  try {
+    const directory = await stateDirectory();
+    const handle = directory && await directory.getFileHandle(`${slot}.bin`, { create: true });
+    const writable = handle && (handle as unknown as WritableFileHandle).createWritable;
+    if (handle && writable) {
+      const stream = await writable.call(handle);
+      await stream.write(encodeFile(key, state));
+      await stream.close();
+    } else {
+      await storeRequest('readwrite', store => store.put({ key, state } as StoredSnapshot, slot));
+    }
+    console.log(`💾 Cached engine state ${slot} (${(state.length / 1024).toFixed(0)} KiB)`);
+  } catch (error) {
+    console.warn(`⚠️ Could not cache engine state ${slot}:`, error);
+  }
+}
@@ -0,0 +1,172 @@
+// Native benchmark driver for the entropy engine (no Emscripten): loads every
+// public/words_N_letters.json and times getPattern, calculateEntropy, calculateAllEntropies and
+// filterWords under constraint sets taken from simulated guesses. Prints one JSON object per
+// line so runs can be diffed or graphed.
+//
+//   npm run bench:native -- [--words-dir public] [--lengths 5,6] [--scenarios 8]
+//       [--threads N] [--max-pairs 200000000]
+
+#include "native_tools.h"
+
+#include <cstdio>
+#include <sys/resource.h>
+
+namespace {
+
+using namespace native_tools;
+
+struct Options {
+    std::string wordsDir = "public";
+    std::vector<int> lengths;   // empty: every dictionary found
+    int scenarios = 8;
+    int threads = 0;            // 0: hardware concurrency
+    double maxPairs = 2e8;      // skip full rankings larger than this many pairs
+};
+
+long peakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Deterministic spread of indices so runs are comparable
+size_t pick(size_t seed, size_t count) {
+    return static_cast<size_t>((seed * 2654435761u + 12345u) % count);
+}
+
+std::vector<std::string> sampleWords(const std::vector<std::string>& words, size_t count, size_t seed) {
+    std::vector<std::string> sample;
+    for (size_t i = 0; i < std::min(count, words.size()); i++) {
+        sample.push_back(words[pick(seed + i, words.size())]);
+    }
+    return sample;
+}
+
+// `extra` is appended as further JSON fields (starting with a comma)
+void report(size_t length, size_t wordCount, const char* op, const char* scenario,
+            double pairs, double words, double seconds, const std::string& extra = "") {
+    std::printf("{\"length\":%zu,\"words\":%zu,\"op\":\"%s\",\"scenario\":\"%s\",\"pairs\":%.0f,"
+                "\"seconds\":%.6f,\"ns_per_pair\":%.3f,\"words_per_second\":%.1f,\"peak_rss_kb\":%ld%s}\n",
+                length, wordCount, op, scenario, pairs, seconds,
+                pairs > 0 ? seconds * 1e9 / pairs : 0.0, seconds > 0 ? words / seconds : 0.0, peakRssKb(),
+                extra.c_str());
+    std::fflush(stdout);
+}
+
+// Raw kernel: pattern codes for a sample of guess x answer pairs
+void benchGetPattern(const std::vector<std::string>& words) {
+    size_t length = words[0].length();
+    std::vector<std::string> sample = sampleWords(words, 1000, 1);
+    std::vector<uint8_t> rows(sample.size() * length);
+    for (size_t i = 0; i < sample.size(); i++) {
+        for (size_t p = 0; p < length; p++) rows[i * length + p] = letterIndex(sample[i][p]);
+    }
+
+    PatternCode checksum = 0;
+    auto start = Clock::now();
+    for (size_t g = 0; g < sample.size(); g++) {
+        for (size_t a = 0; a < sample.size(); a++) {
+            checksum += computePatternCode(&rows[g * length], &rows[a * length], length);
+        }
+    }
+    double seconds = secondsSince(start);
+    if (checksum == 1) std::fprintf(stderr, "\n"); // keeps the loop from being optimized out
+    double pairs = static_cast<double>(sample.size()) * sample.size();
+    report(length, words.size(), "getPattern", "sample", pairs, static_cast<double>(sample.size()), seconds);
+}
+
+void benchCalculateEntropy(EntropyCalculator& calculator, const std::vector<std::string>& words) {
+    calculator.setWordLists(words, words);
+    std::vector<std::string> guesses = sampleWords(words, 100, 2);
+    double total = 0;
+    auto start = Clock::now();
+    for (const std::string& guess : guesses) total += calculator.calculateEntropy(guess);
+    double seconds = secondsSince(start);
+    if (total < 0) std::fprintf(stderr, "\n");
+    report(words[0].length(), words.size(), "calculateEntropy", "unconstrained",
+           static_cast<double>(guesses.size()) * words.size(), static_cast<double>(guesses.size()), seconds);
+}
+
+void benchRanking(EntropyCalculator& calculator, const std::vector<std::string>& words,
+                  const std::vector<std::string>& answers, const char* scenario, const Options& options) {
+    double pairs = static_cast<double>(words.size()) * answers.size();
+    if (answers.empty() || pairs > options.maxPairs) return;
+    calculator.resetStats();
+    calculator.setWordLists(words, answers);
+    auto start = Clock::now();
+    size_t ranked = calculator.calculateAllEntropies().size();
+    double seconds = secondsSince(start);
+
+    // Phase split from the engine's own counters (zeros when built without ENTROPY_ENABLE_STATS)
+    EngineStats stats = calculator.getStats();
+    char phases[160];
+    std::snprintf(phases, sizeof(phases), ",\"marshal_in_ms\":%.3f,\"compute_ms\":%.3f,\"sort_ms\":%.3f",
+                  stats.marshalInMs, stats.computeMs, stats.sortMs);
+    report(words[0].length(), words.size(), "calculateAllEntropies", scenario, pairs,
+           static_cast<double>(ranked), seconds, phases);
+}
+
+void benchDictionary(const std::vector<std::string>& words, const Options& options) {
+    EntropyCalculator calculator;
+    if (options.threads > 0) calculator.setThreadCount(options.threads);
+
+    benchGetPattern(words);
+    benchCalculateEntropy(calculator, words);
+    benchRanking(calculator, words, words, "unconstrained", options);
+
+    // One and two guesses into a game against a spread of secrets
+    double filterSeconds = 0;
+    double filtered = 0;
+    for (int s = 0; s < options.scenarios; s++) {
+        std::string secret = words[pick(100 + s, words.size())];
+        std::vector<std::string> guesses = {words[pick(200 + s, words.size())]};
+        for (int round = 0; round < 2; round++) {
+            WordConstraints constraints = constraintsFor(guesses, secret);
+            auto start = Clock::now();
+            std::vector<std::string> answers = calculator.filterWords(words, constraints);
+            filterSeconds += secondsSince(start);
+            filtered += static_cast<double>(words.size());
+
+            benchRanking(calculator, words, answers, round == 0 ? "after_one_guess" : "after_two_guesses", options);
+            guesses.push_back(answers.empty() ? secret : answers[pick(300 + s, answers.size())]);
+        }
+    }
+    report(words[0].length(), words.size(), "filterWords", "constrained", filtered, filtered, filterSeconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--words-dir") options.wordsDir = value;
+        else if (flag == "--lengths") options.lengths = parseLengths(value);
+        else if (flag == "--scenarios") options.scenarios = std::atoi(value.c_str());
+        else if (flag == "--threads") options.threads = std::atoi(value.c_str());
+        else if (flag == "--max-pairs") options.maxPairs = std::atof(value.c_str());
+        else {
+            std::fprintf(stderr, "unknown option %s\n", flag.c_str());
+            return 2;
+        }
+    }
+
+    std::vector<int> lengths = options.lengths;
+    if (lengths.empty()) {
+        for (int length = 1; length <= 32; length++) lengths.push_back(length);
+    }
+
+    int loaded = 0;
+    std::vector<std::string> words;
+    for (int length : lengths) {
+        if (!loadWords(dictionaryPath(options.wordsDir, length), words)) continue;
+        benchDictionary(words, options);
+        loaded++;
+    }
+    if (loaded == 0) {
+        std::fprintf(stderr, "no dictionaries found in %s\n", options.wordsDir.c_str());
+        return 1;
+    }
+    return 0;
+}
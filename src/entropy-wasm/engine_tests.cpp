@@ -0,0 +1,515 @@
+// Native correctness checks for the entropy engine (no Emscripten), run by CTest: on samples of
+// the shipped dictionaries, every fast path is compared against a plain string reference
+// written here - the length-specialized and SIMD pattern kernels, rankings from packed and
+// string lists with and without SIMD, the pattern matrix and its tiles, answer priors, the
+// posting-bitset filters over feedback boards (repeated letters included) and hard mode. Prints
+// one line per length and check group, then FAIL lines for mismatches; exits non-zero on any.
+//
+//   ctest --test-dir src/entropy-wasm/build/native --output-on-failure
+//   src/entropy-wasm/build/native/entropy-tests [--words-dir public] [--lengths 3,5,6,14]
+//       [--answers 300] [--boards 200]
+
+#include "native_tools.h"
+
+#include <cstdio>
+#include <map>
+#include <random>
+
+namespace {
+
+using namespace native_tools;
+
+struct Options {
+    std::string wordsDir = "public";
+    std::vector<int> lengths = {3, 5, 6, 14}; // inline histogram, SIMD, and past SIMD_MAX_LENGTH
+    size_t answers = 300;                     // answer sample per length; every word is a guess
+    int boards = 200;                         // constraint boards per length
+};
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        failures++;
+        if (failures <= 20) std::printf("FAIL %s\n", what.c_str());
+    }
+}
+
+// G/Y/B tiles by the game rules: greens first, then yellows left to right while unmatched
+// copies of the letter remain
+std::string referencePattern(const std::string& guess, const std::string& secret) {
+    std::string tiles(guess.length(), 'B');
+    int unmatched[256] = {0};
+    for (size_t i = 0; i < guess.length(); i++) {
+        if (guess[i] == secret[i]) tiles[i] = 'G';
+        else unmatched[static_cast<unsigned char>(secret[i])]++;
+    }
+    for (size_t i = 0; i < guess.length(); i++) {
+        if (tiles[i] != 'G' && unmatched[static_cast<unsigned char>(guess[i])] > 0) {
+            tiles[i] = 'Y';
+            unmatched[static_cast<unsigned char>(guess[i])]--;
+        }
+    }
+    return tiles;
+}
+
+// Entropy in bits of the feedback `guess` gets over `answers`, each weighted when given
+double referenceEntropy(const std::string& guess, const std::vector<std::string>& answers,
+                        const std::vector<double>& weights) {
+    std::map<std::string, double> buckets;
+    double total = 0.0;
+    for (size_t a = 0; a < answers.size(); a++) {
+        double weight = weights.empty() ? 1.0 : weights[a];
+        buckets[referencePattern(guess, answers[a])] += weight;
+        total += weight;
+    }
+    double entropy = 0.0;
+    for (const auto& bucket : buckets) {
+        double p = bucket.second / total;
+        entropy -= p * std::log2(p);
+    }
+    return entropy;
+}
+
+std::map<char, size_t> letterCounts(const std::string& word) {
+    std::map<char, size_t> counts;
+    for (char letter : word) counts[letter]++;
+    return counts;
+}
+
+// Revealed copies per letter: max(greens, yellow entries), as CompiledConstraints counts them
+std::map<char, size_t> revealedCounts(const WordConstraints& board) {
+    std::map<char, size_t> greens;
+    std::map<char, size_t> yellows;
+    for (const std::string& known : board.knownPositions) {
+        if (!known.empty()) greens[known[0]]++;
+    }
+    for (const YellowLetter& yellow : board.yellowLetters) {
+        if (!yellow.letter.empty()) yellows[yellow.letter[0]]++;
+    }
+    std::map<char, size_t> revealed = greens;
+    for (const auto& entry : yellows) revealed[entry.first] = std::max(revealed[entry.first], entry.second);
+    return revealed;
+}
+
+bool referenceMatches(const std::string& word, const WordConstraints& board) {
+    for (size_t i = 0; i < board.knownPositions.size() && i < word.length(); i++) {
+        const std::string& known = board.knownPositions[i];
+        if (!known.empty() && word[i] != known[0]) return false;
+    }
+    for (const YellowLetter& yellow : board.yellowLetters) {
+        for (int position : yellow.excludedPositions) {
+            if (position >= 0 && static_cast<size_t>(position) < word.length() && word[position] == yellow.letter[0]) {
+                return false;
+            }
+        }
+    }
+    std::map<char, size_t> counts = letterCounts(word);
+    std::map<char, size_t> revealed = revealedCounts(board);
+    for (const auto& entry : revealed) {
+        if (counts[entry.first] < entry.second) return false;
+    }
+    // A gray letter caps the copies at the revealed ones
+    for (const std::string& gray : board.grayLetters) {
+        if (!gray.empty() && counts[gray[0]] > revealed[gray[0]]) return false;
+    }
+    return true;
+}
+
+// Hard-mode guess rule: greens in place, every revealed letter reused as often as revealed
+bool referenceHints(const std::string& word, const WordConstraints& board) {
+    for (size_t i = 0; i < board.knownPositions.size() && i < word.length(); i++) {
+        const std::string& known = board.knownPositions[i];
+        if (!known.empty() && word[i] != known[0]) return false;
+    }
+    std::map<char, size_t> counts = letterCounts(word);
+    for (const auto& entry : revealedCounts(board)) {
+        if (counts[entry.first] < entry.second) return false;
+    }
+    return true;
+}
+
+bool hasRepeatedLetter(const std::string& word) {
+    for (const auto& entry : letterCounts(word)) {
+        if (entry.second > 1) return true;
+    }
+    return false;
+}
+
+// Evenly spaced words of the dictionary
+std::vector<std::string> sampleAnswers(const std::vector<std::string>& words, size_t count) {
+    if (words.size() <= count) return words;
+    std::vector<std::string> sample;
+    double step = static_cast<double>(words.size()) / count;
+    for (size_t i = 0; i < count; i++) sample.push_back(words[static_cast<size_t>(i * step)]);
+    return sample;
+}
+
+// Of a spread of guesses, the one whose feedback against `secret` keeps the most answers, so
+// the narrowed checks still score a wide set
+std::string wideOpener(const std::vector<std::string>& words, const std::vector<std::string>& answers,
+                       const std::string& secret) {
+    std::string best;
+    size_t bestKept = 0;
+    for (size_t i = 0; i < 64; i++) {
+        const std::string& word = words[(i * 7919) % words.size()];
+        std::string tiles = referencePattern(word, secret);
+        size_t kept = 0;
+        for (const std::string& answer : answers) kept += referencePattern(word, answer) == tiles;
+        if (best.empty() || kept > bestKept) {
+            best = word;
+            bestKept = kept;
+        }
+    }
+    return best;
+}
+
+// Guess index -> entropy from the result buffers; false when an index repeats
+bool resultEntropies(const EntropyCalculator& engine, int count, std::map<uint32_t, float>& entropies) {
+    entropies.clear();
+    for (int i = 0; i < count; i++) {
+        if (!entropies.emplace(engine.getResultIndices()[i], engine.getResultEntropies()[i]).second) return false;
+    }
+    return true;
+}
+
+// Every guess of `guesses` ranked once, each within float rounding of the reference
+void checkFullRanking(EntropyCalculator& engine, const std::vector<std::string>& guesses,
+                      const std::vector<double>& reference, const std::string& label) {
+    int count = engine.calculateAllEntropiesPacked();
+    std::map<uint32_t, float> entropies;
+    bool ok = resultEntropies(engine, count, entropies) && count == static_cast<int>(guesses.size());
+    for (const auto& entry : entropies) {
+        ok = ok && entry.first < reference.size() && std::fabs(entry.second - reference[entry.first]) < 1e-4;
+    }
+    check(ok, label + " full ranking");
+}
+
+// The top k by the reference: same entropies rank by rank, and each returned guess scores what
+// the reference gives it (ties may order either way)
+void checkTopRanking(EntropyCalculator& engine, const std::vector<double>& reference, int k,
+                     const std::string& label) {
+    std::vector<double> sorted = reference;
+    std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+    int count = engine.calculateTopEntropies(k);
+    bool ok = count == std::min<int>(k, static_cast<int>(reference.size()));
+    for (int i = 0; ok && i < count; i++) {
+        uint32_t index = engine.getResultIndices()[i];
+        ok = index < reference.size() && std::fabs(engine.getResultEntropies()[i] - sorted[i]) < 1e-4 &&
+             std::fabs(reference[index] - sorted[i]) < 1e-4;
+    }
+    check(ok, label + " top " + std::to_string(k));
+}
+
+std::vector<double> referenceRanking(const std::vector<std::string>& guesses, const std::vector<std::string>& answers,
+                                     const std::vector<double>& weights = {}) {
+    std::vector<double> entropies(guesses.size());
+    for (size_t g = 0; g < guesses.size(); g++) entropies[g] = referenceEntropy(guesses[g], answers, weights);
+    return entropies;
+}
+
+// Specialized (entry N) and run-time-length (entry 0) kernels, with and without SIMD, against
+// referencePattern; the guesses lead with repeated-letter words
+void checkKernels(const std::vector<std::string>& words, const std::vector<std::string>& answers) {
+    size_t length = words[0].length();
+    std::vector<std::string> guesses;
+    for (const std::string& word : words) {
+        if (guesses.size() < 40 && hasRepeatedLetter(word)) guesses.push_back(word);
+    }
+    for (size_t i = 0; i < 40 && i < words.size(); i++) guesses.push_back(words[(i * 7919) % words.size()]);
+
+    WordStore store;
+    store.assign(answers);
+    store.buildColumns();
+    std::vector<PatternCode> codes(store.size());
+    // The kernels take simd only within SIMD_MAX_LENGTH, as the calculator's useSimd gates them
+#ifdef ENTROPY_SIMD
+    bool simdFits = length <= SIMD_MAX_LENGTH;
+#else
+    bool simdFits = false;
+#endif
+    int checked = 0;
+    for (size_t entry : {length <= MAX_SPECIALIZED_LENGTH ? length : size_t(0), size_t(0)}) {
+        for (bool simd : {false, true}) {
+            if (simd && !simdFits) continue;
+            bool ok = true;
+            for (const std::string& guessWord : guesses) {
+                std::vector<uint8_t> guess(length);
+                for (size_t i = 0; i < length; i++) guess[i] = letterIndex(guessWord[i]);
+                std::fill(codes.begin(), codes.end(), PatternCode(0));
+                kernelsFor(entry).patternRow(guess.data(), store, simd, codes.data());
+                for (size_t a = 0; ok && a < answers.size(); a++) {
+                    ok = decodePattern(codes[a], length) == referencePattern(guessWord, answers[a]);
+                    if (!ok) {
+                        std::printf("  %s vs %s: %s, expected %s\n", guessWord.c_str(), answers[a].c_str(),
+                                    decodePattern(codes[a], length).c_str(),
+                                    referencePattern(guessWord, answers[a]).c_str());
+                    }
+                }
+                checked++;
+            }
+            check(ok, "kernel entry " + std::to_string(entry) + (simd ? " simd" : " scalar"));
+        }
+    }
+    std::printf("length %zu: %d kernel rows over %zu answers\n", length, checked, answers.size());
+}
+
+// Rankings from each way of loading and scoring (the worker pool included), before and after feedback narrows the answers
+void checkRankings(const std::vector<std::string>& words, const std::vector<std::string>& answers) {
+    size_t length = words[0].length();
+    std::vector<double> reference = referenceRanking(words, answers);
+
+    std::string secret = answers[answers.size() / 3];
+    std::string opener = wideOpener(words, answers, secret);
+    std::string tiles = referencePattern(opener, secret);
+    std::vector<std::string> narrowed;
+    for (const std::string& answer : answers) {
+        if (referencePattern(opener, answer) == tiles) narrowed.push_back(answer);
+    }
+    std::vector<double> narrowedReference = referenceRanking(words, narrowed);
+
+    // Lowercase rows, as the packed entry point accepts any case
+    std::vector<uint8_t> guessRows;
+    std::vector<uint8_t> answerRows;
+    for (const std::string& word : words) {
+        for (char letter : word) guessRows.push_back(static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(letter))));
+    }
+    for (const std::string& word : answers) answerRows.insert(answerRows.end(), word.begin(), word.end());
+
+    const char* modes[] = {"strings", "packed", "scalar", "threaded", "matrix", "tiled"};
+    for (const char* mode : modes) {
+        std::string label = "length " + std::to_string(length) + " " + mode;
+        EntropyCalculator engine;
+        engine.setCacheBudget(0);
+        if (std::string(mode) == "scalar") engine.setSimdEnabled(false);
+        if (std::string(mode) == "threaded") engine.setThreadCount(4);
+        if (std::string(mode) == "matrix" || std::string(mode) == "tiled") engine.setMatrixMode(true);
+        if (std::string(mode) == "tiled") engine.setMatrixBudget(words.size() * answers.size() / 8.0);
+        if (std::string(mode) == "packed") {
+            engine.setWordListsPacked(reinterpret_cast<uintptr_t>(guessRows.data()), words.size(),
+                                      reinterpret_cast<uintptr_t>(answerRows.data()), answers.size(), length);
+        } else {
+            engine.setWordLists(words, answers);
+        }
+        bool matrixFits = length <= PatternMatrix::MAX_WORD_LENGTH;
+        if (std::string(mode) == "matrix" && matrixFits) check(engine.isMatrixActive(), label + " matrix built");
+        if (std::string(mode) == "tiled") check(!engine.isMatrixActive(), label + " matrix over budget");
+
+        checkFullRanking(engine, words, reference, label);
+        checkTopRanking(engine, reference, 10, label);
+        if (std::string(mode) == "tiled" && matrixFits) check(engine.getTileCacheBytes() > 0, label + " tiles used");
+        check(engine.applyFeedback(opener, tiles) == static_cast<int>(narrowed.size()), label + " feedback count");
+        checkTopRanking(engine, narrowedReference, 10, label + " after feedback");
+        checkFullRanking(engine, words, narrowedReference, label + " after feedback");
+        engine.undoFeedback();
+        checkTopRanking(engine, reference, 5, label + " after undo");
+    }
+
+    // Priors: the engine rounds weights to integers, which small whole weights survive exactly
+    std::vector<float> priors(answers.size());
+    std::vector<double> weights(answers.size());
+    for (size_t i = 0; i < priors.size(); i++) weights[i] = priors[i] = static_cast<float>(1 + i * 7 % 13);
+    std::vector<double> weightedReference = referenceRanking(words, answers, weights);
+    for (bool matrix : {false, true}) {
+        std::string label = "length " + std::to_string(length) + (matrix ? " matrix" : "") + " priors";
+        EntropyCalculator engine;
+        engine.setMatrixMode(matrix);
+        engine.setWordLists(words, answers);
+        check(engine.setAnswerPriors(reinterpret_cast<uintptr_t>(priors.data()), priors.size()), label + " accepted");
+        checkFullRanking(engine, words, weightedReference, label);
+        checkTopRanking(engine, weightedReference, 10, label);
+    }
+    std::printf("length %zu: rankings of %zu guesses over %zu and %zu answers\n", length, words.size(),
+                answers.size(), narrowed.size());
+}
+
+// Boards from played guesses (half of them opening on repeated-letter words) and arbitrary ones
+WordConstraints makeBoard(const std::vector<std::string>& words, const std::vector<std::string>& repeated,
+                          std::mt19937& rng, int round) {
+    size_t length = words[0].length();
+    if (round % 3 != 2) {
+        std::string secret = words[rng() % words.size()];
+        std::vector<std::string> guesses;
+        if (round % 2 == 0 && !repeated.empty()) guesses.push_back(repeated[rng() % repeated.size()]);
+        int played = 1 + static_cast<int>(rng() % 3);
+        for (int i = 0; i < played; i++) guesses.push_back(words[rng() % words.size()]);
+        return constraintsFor(guesses, secret);
+    }
+    WordConstraints board;
+    board.knownPositions.assign(length, "");
+    for (size_t p = 0; p < length; p++) {
+        if (rng() % 5 == 0) board.knownPositions[p] = std::string(1, static_cast<char>('A' + rng() % 26));
+    }
+    int yellows = static_cast<int>(rng() % 4);
+    for (int i = 0; i < yellows; i++) {
+        YellowLetter yellow;
+        yellow.letter = std::string(1, static_cast<char>('A' + rng() % 26));
+        int excluded = static_cast<int>(rng() % 3);
+        for (int e = 0; e < excluded; e++) yellow.excludedPositions.push_back(static_cast<int>(rng() % length));
+        board.yellowLetters.push_back(yellow);
+    }
+    int grays = static_cast<int>(rng() % 8);
+    for (int i = 0; i < grays; i++) board.grayLetters.push_back(std::string(1, static_cast<char>('A' + rng() % 26)));
+    return board;
+}
+
+// filterWords, the posting-bitset dictionary filters, applyConstraints and hard mode against
+// the reference rules
+void checkBoards(const std::vector<std::string>& words, const std::vector<std::string>& answers, int rounds) {
+    size_t length = words[0].length();
+    std::vector<std::string> repeated;
+    for (const std::string& word : words) {
+        if (hasRepeatedLetter(word)) repeated.push_back(word);
+    }
+
+    EntropyCalculator engine;
+    engine.setCacheBudget(0);
+    engine.setWordLists(words, answers);
+    EntropyCalculator scalar;
+    scalar.setSimdEnabled(false);
+    std::mt19937 rng(static_cast<uint32_t>(length));
+    size_t matched = 0;
+    for (int round = 0; round < rounds; round++) {
+        WordConstraints board = makeBoard(words, repeated, rng, round);
+        std::string label = "length " + std::to_string(length) + " board " + std::to_string(round);
+        std::vector<std::string> expected;
+        std::vector<uint32_t> expectedRows;
+        for (size_t i = 0; i < words.size(); i++) {
+            if (referenceMatches(words[i], board)) {
+                expected.push_back(words[i]);
+                expectedRows.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        std::vector<uint32_t> expectedAnswers;
+        for (size_t i = 0; i < answers.size(); i++) {
+            if (referenceMatches(answers[i], board)) expectedAnswers.push_back(static_cast<uint32_t>(i));
+        }
+        matched += expected.size();
+
+        check(engine.filterWords(words, board) == expected, label + " filterWords");
+        check(scalar.filterWords(words, board) == expected, label + " scalar filterWords");
+        engine.setConstraints(board);
+        check(engine.countDictionaryMatches() == static_cast<int>(expected.size()), label + " countDictionaryMatches");
+        check(engine.filterDictionary() == expected, label + " filterDictionary");
+        int packed = engine.filterDictionaryPacked();
+        check(std::vector<uint32_t>(engine.getResultIndices().begin(), engine.getResultIndices().begin() + packed) ==
+              expectedRows, label + " filterDictionaryPacked");
+
+        engine.resetCandidates();
+        check(engine.applyConstraints() == static_cast<int>(expectedAnswers.size()), label + " applyConstraints");
+        int candidates = engine.getCandidateIndices();
+        check(std::vector<uint32_t>(engine.getResultIndices().begin(), engine.getResultIndices().begin() + candidates) ==
+              expectedAnswers, label + " getCandidateIndices");
+
+        // Hard mode: the allowed guesses, and a ranking over exactly those
+        std::vector<std::string> allowed;
+        std::unordered_map<std::string, size_t> allowedIndex;
+        for (const std::string& word : words) {
+            if (referenceHints(word, board)) {
+                allowedIndex.emplace(word, allowed.size());
+                allowed.push_back(word);
+            }
+        }
+        engine.setHardMode(true);
+        check(engine.getAllowedGuessCount() == static_cast<int>(allowed.size()), label + " hard-mode guesses");
+        if (round % 10 == 0 && expectedAnswers.size() > 1 && !allowed.empty()) {
+            std::vector<std::string> remaining;
+            for (uint32_t row : expectedAnswers) remaining.push_back(answers[row]);
+            std::vector<double> reference = referenceRanking(allowed, remaining);
+            int count = engine.calculateAllEntropiesPacked();
+            bool ok = count == static_cast<int>(allowed.size());
+            for (int i = 0; ok && i < count; i++) {
+                std::string guess = engine.getGuessWord(static_cast<int>(engine.getResultIndices()[i]));
+                auto found = allowedIndex.find(guess);
+                ok = found != allowedIndex.end() &&
+                     std::fabs(engine.getResultEntropies()[i] - reference[found->second]) < 1e-4;
+            }
+            check(ok, label + " hard-mode ranking");
+        }
+        engine.setHardMode(false);
+        engine.resetCandidates();
+    }
+    std::printf("length %zu: %d boards, %zu dictionary matches\n", length, rounds, matched);
+}
+
+// Warm-start snapshots carry the priors, and the lookahead leaves the candidates (and a pending
+// ranking job) as they were
+void checkState(const std::vector<std::string>& words, const std::vector<std::string>& answers) {
+    size_t length = words[0].length();
+    std::string label = "length " + std::to_string(length);
+    std::vector<float> priors(answers.size());
+    for (size_t i = 0; i < priors.size(); i++) priors[i] = static_cast<float>(1 + i * 5 % 11);
+
+    EntropyCalculator engine;
+    engine.setWordLists(words, answers);
+    engine.setAnswerPriors(reinterpret_cast<uintptr_t>(priors.data()), priors.size());
+    int bytes = engine.serializeState();
+    std::vector<uint8_t> state = engine.getStateBuffer();
+    EntropyCalculator restored;
+    check(bytes == static_cast<int>(state.size()) &&
+          restored.restoreState(reinterpret_cast<uintptr_t>(state.data()), state.size()), label + " restore");
+    check(restored.hasAnswerPriors(), label + " restored priors");
+    int count = engine.calculateTopEntropies(10);
+    std::vector<uint32_t> indices(engine.getResultIndices().begin(), engine.getResultIndices().begin() + count);
+    std::vector<float> entropies(engine.getResultEntropies().begin(), engine.getResultEntropies().begin() + count);
+    int restoredCount = restored.calculateTopEntropies(10);
+    check(restoredCount == count &&
+          std::vector<uint32_t>(restored.getResultIndices().begin(), restored.getResultIndices().begin() + count) == indices &&
+          std::vector<float>(restored.getResultEntropies().begin(), restored.getResultEntropies().begin() + count) == entropies,
+          label + " restored ranking");
+
+    std::string secret = answers[answers.size() / 4];
+    std::string opener = wideOpener(words, answers, secret);
+    engine.clearAnswerPriors();
+    engine.applyFeedback(opener, referencePattern(opener, secret));
+    std::vector<std::string> before = engine.getCandidates();
+    engine.setSolverDepth(2);
+    engine.setSolverBreadth(4);
+    engine.beginRankingJob(5);
+    engine.solveLookahead(3);
+    check(engine.getCandidates() == before, label + " lookahead keeps candidates");
+    bool stepped = true;
+    while (stepped && !engine.isRankingJobDone()) stepped = engine.stepRankingJob(5) >= 0;
+    check(stepped && engine.finishRankingJob() >= 0, label + " ranking job survives lookahead");
+    std::printf("length %zu: snapshot %d bytes, lookahead over %zu candidates\n", length, bytes, before.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--words-dir") options.wordsDir = value;
+        else if (flag == "--lengths") options.lengths = parseLengths(value);
+        else if (flag == "--answers") options.answers = static_cast<size_t>(std::atoi(value.c_str()));
+        else if (flag == "--boards") options.boards = std::atoi(value.c_str());
+        else {
+            std::fprintf(stderr, "unknown option %s\n", flag.c_str());
+            return 2;
+        }
+    }
+
+    std::vector<std::string> words;
+    for (int length : options.lengths) {
+        if (!loadWords(dictionaryPath(options.wordsDir, length), words)) {
+            std::fprintf(stderr, "missing dictionary %s\n", dictionaryPath(options.wordsDir, length).c_str());
+            return 1;
+        }
+        words.erase(std::remove_if(words.begin(), words.end(),
+                                   [&](const std::string& word) { return word.length() != static_cast<size_t>(length); }),
+                    words.end());
+        std::vector<std::string> answers = sampleAnswers(words, options.answers);
+        checkKernels(words, answers);
+        checkRankings(words, answers);
+        checkBoards(words, answers, options.boards);
+        checkState(words, answers);
+    }
+    if (failures > 0) {
+        std::printf("%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
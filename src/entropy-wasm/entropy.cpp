@@ -1,253 +1,271 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
-#include <vector>
-#include <string>
-#include <unordered_map>
-#include <algorithm>
-#include <cmath>
-#include <iostream>
+
+#include "entropy_engine.h"
+
+// embind layer over entropy_engine.h: converts JS arrays and objects to the engine's plain C++
+// types and exposes result buffers as typed-array views into the module heap
 
 using namespace emscripten;
 
-class EntropyCalculator {
-private:
-    std::vector<std::string> allWords;
-    std::vector<std::string> possibleAnswers;
-    
-    // High-performance pattern generation
-    std::string getPattern(const std::string& guess, const std::string& target) {
-        std::string result(guess.length(), 'B'); // Initialize as all black
-        std::vector<int> targetFreq(26, 0);
-        
-        // Count target letter frequencies
-        for (char c : target) {
-            targetFreq[c - 'A']++;
-        }
-        
-        // First pass: mark green letters and reduce frequency
-        for (size_t i = 0; i < guess.length(); i++) {
-            if (guess[i] == target[i]) {
-                result[i] = 'G';
-                targetFreq[guess[i] - 'A']--;
-            }
-        }
-        
-        // Second pass: mark yellow letters
-        for (size_t i = 0; i < guess.length(); i++) {
-            if (result[i] == 'B' && targetFreq[guess[i] - 'A'] > 0) {
-                result[i] = 'Y';
-                targetFreq[guess[i] - 'A']--;
-            }
-        }
-        
-        return result;
+namespace {
+
+std::vector<std::string> toStrings(const val& array) {
+    std::vector<std::string> result;
+    int total = array["length"].as<int>();
+    result.reserve(total);
+    for (int i = 0; i < total; i++) {
+        result.push_back(array[i].as<std::string>());
     }
+    return result;
+}
 
-public:
-    EntropyCalculator() {}
-    
-    // Set word lists for calculations
-    void setWordLists(const val& allWordsJS, const val& possibleAnswersJS) {
-        allWords.clear();
-        possibleAnswers.clear();
-        
-        // Convert JavaScript arrays to C++ vectors
-        for (int i = 0; i < allWordsJS["length"].as<int>(); i++) {
-            std::string word = allWordsJS[i].as<std::string>();
-            std::transform(word.begin(), word.end(), word.begin(), ::toupper);
-            allWords.push_back(word);
-        }
-        
-        for (int i = 0; i < possibleAnswersJS["length"].as<int>(); i++) {
-            std::string word = possibleAnswersJS[i].as<std::string>();
-            std::transform(word.begin(), word.end(), word.begin(), ::toupper);
-            possibleAnswers.push_back(word);
-        }
-        
-        std::cout << "🔧 C++ EntropyCalculator initialized with " 
-                  << allWords.size() << " total words and " 
-                  << possibleAnswers.size() << " possible answers" << std::endl;
+val toArray(const std::vector<std::string>& words) {
+    val result = val::array();
+    for (const std::string& word : words) {
+        result.call<void>("push", word);
     }
-    
-    // High-performance entropy calculation
-    double calculateEntropy(const std::string& guessWord) {
-        if (possibleAnswers.size() <= 1) {
-            return 0.0;
-        }
-        
-        std::string upperGuess = guessWord;
-        std::transform(upperGuess.begin(), upperGuess.end(), upperGuess.begin(), ::toupper);
-        
-        // Count pattern frequencies using unordered_map for O(1) lookups
-        std::unordered_map<std::string, int> patternCounts;
-        
-        for (const std::string& answer : possibleAnswers) {
-            std::string pattern = getPattern(upperGuess, answer);
-            patternCounts[pattern]++;
-        }
-        
-        // Calculate Shannon entropy: H = -Σ p(x) * log₂(p(x))
-        double entropy = 0.0;
-        double totalAnswers = static_cast<double>(possibleAnswers.size());
-        
-        for (const auto& pair : patternCounts) {
-            double probability = pair.second / totalAnswers;
-            entropy -= probability * std::log2(probability);
-        }
-        
-        return entropy;
+    return result;
+}
+
+// Refills `strings` in place so its capacity carries over between calls
+void assignStrings(const val& array, std::vector<std::string>& strings) {
+    strings.resize(array["length"].as<size_t>());
+    for (size_t i = 0; i < strings.size(); i++) {
+        strings[i] = array[i].as<std::string>();
     }
-    
-    // Ultra-fast bulk entropy calculation for all words
-    val calculateAllEntropies() {
-        val results = val::array();
-        
-        if (possibleAnswers.empty()) {
-            return results;
-        }
-        
-        std::cout << "🚀 Starting C++ bulk entropy calculation for " 
-                  << allWords.size() << " words..." << std::endl;
-        
-        // Calculate entropy for each word and create result objects
-        std::vector<std::pair<double, std::string>> entropyPairs;
-        entropyPairs.reserve(allWords.size());
-        
-        for (const std::string& word : allWords) {
-            double entropy = calculateEntropy(word);
-            entropyPairs.emplace_back(entropy, word);
-        }
-        
-        // Sort by entropy (highest first) - much faster than JS sorting
-        std::sort(entropyPairs.begin(), entropyPairs.end(), 
-                  [](const auto& a, const auto& b) { return a.first > b.first; });
-        
-        // Convert to JavaScript format
-        for (const auto& pair : entropyPairs) {
-            val result = val::object();
-            result.set("word", pair.second);
-            result.set("entropy", pair.first);
-            result.set("bitsOfInfo", std::round(pair.first * 100.0) / 100.0);
-            results.call<void>("push", result);
+}
+
+// Parses the JS constraint shape used by filterWords into the calculator's reusable holder
+const WordConstraints& toConstraints(EntropyCalculator& self, const val& knownPositionsJS,
+                                     const val& yellowLettersJS, const val& grayLettersJS) {
+    WordConstraints& input = self.constraintScratch();
+    assignStrings(knownPositionsJS, input.knownPositions);
+    assignStrings(grayLettersJS, input.grayLetters);
+    input.yellowLetters.resize(yellowLettersJS["length"].as<size_t>());
+    for (size_t i = 0; i < input.yellowLetters.size(); i++) {
+        val yellowItem = yellowLettersJS[i];
+        YellowLetter& yellow = input.yellowLetters[i];
+        yellow.letter = yellowItem["letter"].as<std::string>();
+        val positions = yellowItem["excludedPositions"];
+        yellow.excludedPositions.clear();
+        for (int j = 0; j < positions["length"].as<int>(); j++) {
+            yellow.excludedPositions.push_back(positions[j].as<int>());
         }
-        
-        std::cout << "✅ C++ bulk entropy calculation completed!" << std::endl;
-        return results;
     }
-    
-    // Fast word filtering with constraints
-    val filterWords(const val& wordsJS, 
-                   const val& knownPositionsJS,
-                   const val& yellowLettersJS, 
-                   const val& grayLettersJS) {
-        
-        std::vector<std::string> words;
-        std::vector<std::string> knownPositions;
-        std::vector<std::string> grayLetters;
-        
-        // Convert JavaScript arrays to C++ vectors
-        for (int i = 0; i < wordsJS["length"].as<int>(); i++) {
-            std::string word = wordsJS[i].as<std::string>();
-            std::transform(word.begin(), word.end(), word.begin(), ::toupper);
-            words.push_back(word);
-        }
-        
-        for (int i = 0; i < knownPositionsJS["length"].as<int>(); i++) {
-            std::string pos = knownPositionsJS[i].as<std::string>();
-            std::transform(pos.begin(), pos.end(), pos.begin(), ::toupper);
-            knownPositions.push_back(pos);
-        }
-        
-        for (int i = 0; i < grayLettersJS["length"].as<int>(); i++) {
-            std::string letter = grayLettersJS[i].as<std::string>();
-            std::transform(letter.begin(), letter.end(), letter.begin(), ::toupper);
-            grayLetters.push_back(letter);
-        }
-        
-        // Process yellow letters (more complex structure)
-        std::vector<std::pair<char, std::vector<int>>> yellowLetters;
-        for (int i = 0; i < yellowLettersJS["length"].as<int>(); i++) {
-            val yellowItem = yellowLettersJS[i];
-            char letter = yellowItem["letter"].as<std::string>()[0];
-            letter = std::toupper(letter);
-            
-            std::vector<int> excludedPositions;
-            val positions = yellowItem["excludedPositions"];
-            for (int j = 0; j < positions["length"].as<int>(); j++) {
-                excludedPositions.push_back(positions[j].as<int>());
-            }
-            yellowLetters.emplace_back(letter, excludedPositions);
-        }
-        
-        // High-performance filtering
-        std::vector<std::string> filtered;
-        filtered.reserve(words.size() / 4); // Reserve space for efficiency
-        
-        for (const std::string& word : words) {
-            bool valid = true;
-            
-            // Check known positions (green letters)
-            for (size_t i = 0; i < knownPositions.size() && i < word.length(); i++) {
-                if (!knownPositions[i].empty() && word[i] != knownPositions[i][0]) {
-                    valid = false;
-                    break;
-                }
-            }
-            
-            if (!valid) continue;
-            
-            // Check yellow letters
-            for (const auto& yellow : yellowLetters) {
-                char letter = yellow.first;
-                const auto& excludedPositions = yellow.second;
-                
-                // Word must contain the letter
-                if (word.find(letter) == std::string::npos) {
-                    valid = false;
-                    break;
-                }
-                
-                // Letter must not be in excluded positions
-                for (int pos : excludedPositions) {
-                    if (pos < word.length() && word[pos] == letter) {
-                        valid = false;
-                        break;
-                    }
-                }
-                if (!valid) break;
-            }
-            
-            if (!valid) continue;
-            
-            // Check gray letters
-            for (const std::string& grayLetter : grayLetters) {
-                if (!grayLetter.empty() && word.find(grayLetter[0]) != std::string::npos) {
-                    valid = false;
-                    break;
-                }
-            }
-            
-            if (valid) {
-                filtered.push_back(word);
-            }
-        }
-        
-        // Convert back to JavaScript array
-        val result = val::array();
-        for (const std::string& word : filtered) {
-            result.call<void>("push", word);
-        }
-        
-        return result;
+    return input;
+}
+
+template <typename T>
+val heapView(const std::vector<T>& values) {
+    return val(typed_memory_view(values.size(), values.data()));
+}
+
+void setWordLists(EntropyCalculator& self, const val& allWordsJS, const val& possibleAnswersJS) {
+    std::vector<std::string> allWords;
+    std::vector<std::string> possibleAnswers;
+    {
+        ENTROPY_PHASE(self.mutableStats(), marshalInMs);
+        allWords = toStrings(allWordsJS);
+        possibleAnswers = toStrings(possibleAnswersJS);
     }
-};
+    self.setWordLists(allWords, possibleAnswers);
+}
+
+int appendStreamWords(EntropyCalculator& self, const val& wordsJS) {
+    return self.appendStreamWords(toStrings(wordsJS));
+}
+
+int filterWordsPacked(EntropyCalculator& self, uintptr_t wordsPointer, size_t wordCount, size_t wordLength,
+                      const val& knownPositionsJS, const val& yellowLettersJS, const val& grayLettersJS) {
+    return self.filterWordsPacked(wordsPointer, wordCount, wordLength,
+                                  toConstraints(self, knownPositionsJS, yellowLettersJS, grayLettersJS));
+}
+
+// Uint32Array view of guess (or filtered word) indices from the last packed call
+val getResultIndices(const EntropyCalculator& self) {
+    return heapView(self.getResultIndices());
+}
+
+// Float32Array view of entropies matching getResultIndices
+val getResultEntropies(const EntropyCalculator& self) {
+    return heapView(self.getResultEntropies());
+}
+
+// Float32Array view of expected guesses matching getResultIndices after solveLookahead
+val getResultScores(const EntropyCalculator& self) {
+    return heapView(self.getResultScores());
+}
+
+// Uint8Array view of the last buildOpeningTable output
+val getOpeningTable(const EntropyCalculator& self) {
+    return heapView(self.getOpeningTable());
+}
+
+// Uint8Array view of the last serializeState output
+val getStateBuffer(const EntropyCalculator& self) {
+    return heapView(self.getStateBuffer());
+}
+
+val calculateAllEntropies(EntropyCalculator& self) {
+    std::vector<RankedGuess> ranking = self.calculateAllEntropies();
+    ENTROPY_PHASE(self.mutableStats(), marshalOutMs);
+    val results = val::array();
+    for (const auto& pair : ranking) {
+        val result = val::object();
+        result.set("word", self.getGuessWord(static_cast<int>(pair.second)));
+        result.set("entropy", pair.first);
+        result.set("bitsOfInfo", std::round(pair.first * 100.0) / 100.0);
+        results.call<void>("push", result);
+    }
+    return results;
+}
+
+val getCandidates(const EntropyCalculator& self) {
+    return toArray(self.getCandidates());
+}
+
+val getBoardCandidates(const EntropyCalculator& self, int board) {
+    return toArray(self.getBoardCandidates(board));
+}
+
+// Words are read from and matches pushed to the JS arrays directly, without vector copies
+val filterWords(EntropyCalculator& self, const val& wordsJS, const val& knownPositionsJS,
+                const val& yellowLettersJS, const val& grayLettersJS) {
+    val results = val::array();
+    self.filterWordsEach(wordsJS["length"].as<size_t>(),
+                         [&](size_t i) { return wordsJS[i].as<std::string>(); },
+                         toConstraints(self, knownPositionsJS, yellowLettersJS, grayLettersJS),
+                         [&](const std::string& word) { results.call<void>("push", word); });
+    return results;
+}
+
+void setConstraints(EntropyCalculator& self, const val& knownPositionsJS, const val& yellowLettersJS,
+                    const val& grayLettersJS) {
+    self.setConstraints(toConstraints(self, knownPositionsJS, yellowLettersJS, grayLettersJS));
+}
+
+val filterDictionary(EntropyCalculator& self) {
+    val results = val::array();
+    self.filterDictionaryEach([&](const std::string& word) { results.call<void>("push", word); });
+    return results;
+}
+
+val getStats(const EntropyCalculator& self) {
+    EngineStats stats = self.getStats();
+    val result = val::object();
+    result.set("enabled", stats.enabled);
+    result.set("pairsEvaluated", static_cast<double>(stats.pairsEvaluated));
+    result.set("patternsComputed", static_cast<double>(stats.patternsComputed));
+    result.set("rankings", static_cast<double>(stats.rankings));
+    result.set("cacheHits", static_cast<double>(stats.cacheHits));
+    result.set("cacheMisses", static_cast<double>(stats.cacheMisses));
+    result.set("tileHits", static_cast<double>(stats.tileHits));
+    result.set("tileMisses", static_cast<double>(stats.tileMisses));
+    result.set("tileBytes", static_cast<double>(stats.tileBytes));
+    result.set("marshalInMs", stats.marshalInMs);
+    result.set("computeMs", stats.computeMs);
+    result.set("sortMs", stats.sortMs);
+    result.set("marshalOutMs", stats.marshalOutMs);
+    result.set("scratchBytes", static_cast<double>(stats.scratchBytes));
+    result.set("scratchBlocks", static_cast<double>(stats.scratchBlocks));
+    return result;
+}
+
+} // namespace
 
 // Bind the class to JavaScript
 EMSCRIPTEN_BINDINGS(entropy_calculator) {
     class_<EntropyCalculator>("EntropyCalculator")
         .constructor<>()
-        .function("setWordLists", &EntropyCalculator::setWordLists)
+        .function("setWordLists", &setWordLists)
+        .function("allocateBuffer", &EntropyCalculator::allocateBuffer)
+        .function("freeBuffer", &EntropyCalculator::freeBuffer)
+        .function("setWordListsPacked", &EntropyCalculator::setWordListsPacked)
+        .function("setDictionaryBinary", &EntropyCalculator::setDictionaryBinary)
+        .function("setAnswerPriors", &EntropyCalculator::setAnswerPriors)
+        .function("clearAnswerPriors", &EntropyCalculator::clearAnswerPriors)
+        .function("hasAnswerPriors", &EntropyCalculator::hasAnswerPriors)
+        .function("serializeState", &EntropyCalculator::serializeState)
+        .function("getStateBuffer", &getStateBuffer)
+        .function("releaseStateBuffer", &EntropyCalculator::releaseStateBuffer)
+        .function("restoreState", &EntropyCalculator::restoreState)
+        .function("beginStream", &EntropyCalculator::beginStream)
+        .function("appendStreamRows", &EntropyCalculator::appendStreamRows)
+        .function("appendStreamWords", &appendStreamWords)
+        .function("getProvisionalTopEntropies", &EntropyCalculator::getProvisionalTopEntropies)
+        .function("endStream", &EntropyCalculator::endStream)
+        .function("isStreaming", &EntropyCalculator::isStreaming)
+        .function("calculateAllEntropiesPacked", &EntropyCalculator::calculateAllEntropiesPacked)
+        .function("calculateTopEntropies", &EntropyCalculator::calculateTopEntropies)
+        .function("beginRankingJob", &EntropyCalculator::beginRankingJob)
+        .function("stepRankingJob", &EntropyCalculator::stepRankingJob)
+        .function("isRankingJobDone", &EntropyCalculator::isRankingJobDone)
+        .function("getRankingJobProgress", &EntropyCalculator::getRankingJobProgress)
+        .function("getRankingJobTotal", &EntropyCalculator::getRankingJobTotal)
+        .function("cancelRankingJob", &EntropyCalculator::cancelRankingJob)
+        .function("getJobCancelPointer", &EntropyCalculator::getJobCancelPointer)
+        .function("finishRankingJob", &EntropyCalculator::finishRankingJob)
+        .function("setSolverDepth", &EntropyCalculator::setSolverDepth)
+        .function("setSolverBreadth", &EntropyCalculator::setSolverBreadth)
+        .function("setSolverTimeBudget", &EntropyCalculator::setSolverTimeBudget)
+        .function("cancelSolve", &EntropyCalculator::cancelSolve)
+        .function("getCancelFlagPointer", &EntropyCalculator::getCancelFlagPointer)
+        .function("solveLookahead", &EntropyCalculator::solveLookahead)
+        .function("isSolveComplete", &EntropyCalculator::isSolveComplete)
+        .function("getResultScores", &getResultScores)
+        .function("buildOpeningTable", &EntropyCalculator::buildOpeningTable)
+        .function("getOpeningTable", &getOpeningTable)
+        .function("setCacheBudget", &EntropyCalculator::setCacheBudget)
+        .function("clearCache", &EntropyCalculator::clearCache)
+        .function("getStats", &getStats)
+        .function("resetStats", &EntropyCalculator::resetStats)
+        .function("getCacheHits", &EntropyCalculator::getCacheHits)
+        .function("getCacheMisses", &EntropyCalculator::getCacheMisses)
+        .function("getCacheBytes", &EntropyCalculator::getCacheBytes)
+        .function("getCacheEntries", &EntropyCalculator::getCacheEntries)
+        .function("setPruningEnabled", &EntropyCalculator::setPruningEnabled)
+        .function("isPruningEnabled", &EntropyCalculator::isPruningEnabled)
+        .function("getLastScoredGuesses", &EntropyCalculator::getLastScoredGuesses)
+        .function("filterWordsPacked", &filterWordsPacked)
+        .function("getResultIndices", &getResultIndices)
+        .function("getResultEntropies", &getResultEntropies)
+        .function("getGuessWord", &EntropyCalculator::getGuessWord)
+        .function("setMatrixMode", &EntropyCalculator::setMatrixMode)
+        .function("setMatrixBudget", &EntropyCalculator::setMatrixBudget)
+        .function("isMatrixActive", &EntropyCalculator::isMatrixActive)
+        .function("getMatrixBytes", &EntropyCalculator::getMatrixBytes)
+        .function("getTileCacheBytes", &EntropyCalculator::getTileCacheBytes)
+        .function("getWordStoreBytes", &EntropyCalculator::getWordStoreBytes)
+        .function("getPostingBytes", &EntropyCalculator::getPostingBytes)
+        .function("setThreadCount", &EntropyCalculator::setThreadCount)
+        .function("getThreadCount", &EntropyCalculator::getThreadCount)
+        .function("setSimdEnabled", &EntropyCalculator::setSimdEnabled)
+        .function("isSimdAvailable", &EntropyCalculator::isSimdAvailable)
+        .function("isSimdEnabled", &EntropyCalculator::isSimdEnabled)
         .function("calculateEntropy", &EntropyCalculator::calculateEntropy)
-        .function("calculateAllEntropies", &EntropyCalculator::calculateAllEntropies)
-        .function("filterWords", &EntropyCalculator::filterWords);
-}
\ No newline at end of file
+        .function("calculateAllEntropies", &calculateAllEntropies)
+        .function("applyFeedback", &EntropyCalculator::applyFeedback)
+        .function("undoFeedback", &EntropyCalculator::undoFeedback)
+        .function("resetCandidates", &EntropyCalculator::resetCandidates)
+        .function("getCandidateCount", &EntropyCalculator::getCandidateCount)
+        .function("getCandidates", &getCandidates)
+        .function("getCandidateIndices", &EntropyCalculator::getCandidateIndices)
+        .function("setBoardCount", &EntropyCalculator::setBoardCount)
+        .function("getBoardCount", &EntropyCalculator::getBoardCount)
+        .function("applyBoardFeedback", &EntropyCalculator::applyBoardFeedback)
+        .function("undoBoardFeedback", &EntropyCalculator::undoBoardFeedback)
+        .function("resetBoards", &EntropyCalculator::resetBoards)
+        .function("getBoardCandidateCount", &EntropyCalculator::getBoardCandidateCount)
+        .function("getBoardCandidates", &getBoardCandidates)
+        .function("calculateBoardTopEntropies", &EntropyCalculator::calculateBoardTopEntropies)
+        .function("filterWords", &filterWords)
+        .function("setConstraints", &setConstraints)
+        .function("setHardMode", &EntropyCalculator::setHardMode)
+        .function("isHardMode", &EntropyCalculator::isHardMode)
+        .function("getAllowedGuessCount", &EntropyCalculator::getAllowedGuessCount)
+        .function("filterDictionary", &filterDictionary)
+        .function("countDictionaryMatches", &EntropyCalculator::countDictionaryMatches)
+        .function("filterDictionaryPacked", &EntropyCalculator::filterDictionaryPacked)
+        .function("applyConstraints", &EntropyCalculator::applyConstraints);
+}
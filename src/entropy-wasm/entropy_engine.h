@@ -0,0 +1,3666 @@
+// Entropy engine core: word stores, pattern kernels, candidate state and the EntropyCalculator
+// API in plain C++ types. entropy.cpp binds it to JavaScript with embind; the native tools
+// (benchmark.cpp, solver.cpp, built by CMakeLists.txt) include it directly.
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <utility>
+
+// Threads are available natively (the CMake tools) and in -pthread WebAssembly builds; the
+// app's builds are single-threaded, one engine per pool worker
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define ENTROPY_THREADS 1
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#endif
+
+// Pattern codes are base-3 numbers: B=0, Y=1, G=2, position i weighted by 3^i.
+// 64 bits hold every code up to 40 letters; longer words wrap, which only risks merging buckets.
+typedef uint64_t PatternCode;
+
+static PatternCode encodePattern(const std::string& pattern) {
+    PatternCode code = 0;
+    for (size_t i = pattern.length(); i-- > 0;) {
+        char tile = static_cast<char>(std::toupper(static_cast<unsigned char>(pattern[i])));
+        code *= 3;
+        if (tile == 'G') code += 2;
+        else if (tile == 'Y') code += 1;
+    }
+    return code;
+}
+
+// Inverse of encodePattern: G/Y/B tiles for a code
+static std::string decodePattern(PatternCode code, size_t length) {
+    std::string pattern(length, 'B');
+    for (size_t i = 0; i < length; i++, code /= 3) {
+        if (code % 3 == 2) pattern[i] = 'G';
+        else if (code % 3 == 1) pattern[i] = 'Y';
+    }
+    return pattern;
+}
+
+static constexpr uint64_t patternSpace(size_t wordLength) {
+    uint64_t size = 1;
+    for (size_t i = 0; i < wordLength; i++) size *= 3;
+    return size;
+}
+
+// Letters A-Z map to 0-25; anything else (the dictionaries only contain '-') shares slot 26
+static constexpr int ALPHABET_SLOTS = 27;
+
+static inline uint8_t letterIndex(char c) {
+    unsigned index = static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(c))) - 'A';
+    return index < 26 ? static_cast<uint8_t>(index) : 26;
+}
+
+static inline char letterChar(uint8_t index) {
+    return index < 26 ? static_cast<char>('A' + index) : '-';
+}
+
+// Allocation-free pattern kernel over packed letter rows, emitted as a base-3 code. N > 0 fixes
+// the length at compile time so both passes unroll; N = 0 reads `length` at run time.
+template <size_t N>
+static inline PatternCode computePatternCodeN(const uint8_t* guess, const uint8_t* target, size_t wordLength) {
+    const size_t length = N ? N : wordLength;
+    int targetFreq[ALPHABET_SLOTS] = {0};
+    PatternCode code = 0;
+    PatternCode weight = 1;
+
+    // First pass: greens, and count the target letters they leave unmatched
+    for (size_t i = 0; i < length; i++) {
+        if (guess[i] == target[i]) {
+            code += 2 * weight;
+        } else {
+            targetFreq[target[i]]++;
+        }
+        weight *= 3;
+    }
+
+    // Second pass: yellows consume the remaining target letters left to right
+    weight = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (guess[i] != target[i] && targetFreq[guess[i]] > 0) {
+            code += weight;
+            targetFreq[guess[i]]--;
+        }
+        weight *= 3;
+    }
+
+    return code;
+}
+
+static PatternCode computePatternCode(const uint8_t* guess, const uint8_t* target, size_t length) {
+    return computePatternCodeN<0>(guess, target, length);
+}
+
+// SIMD kernels, written with GCC/Clang vector extensions so the same code lowers to
+// WebAssembly simd128 (-msimd128) and to SSE2/NEON in native builds
+#if defined(__wasm_simd128__) || defined(__SSE2__) || defined(__ARM_NEON)
+#define ENTROPY_SIMD 1
+
+typedef uint8_t u8x16 __attribute__((vector_size(16)));
+typedef uint16_t u16x16 __attribute__((vector_size(32)));
+
+static constexpr size_t SIMD_LANES = 16;
+static constexpr size_t SIMD_MAX_LENGTH = 10; // codes up to 3^10 fit in 16-bit lanes
+
+static inline u8x16 loadLanes(const uint8_t* data) {
+    u8x16 lanes;
+    std::memcpy(&lanes, data, sizeof(lanes));
+    return lanes;
+}
+
+static inline u8x16 splatLanes(uint8_t value) {
+    u8x16 lanes;
+    for (size_t i = 0; i < SIMD_LANES; i++) lanes[i] = value;
+    return lanes;
+}
+
+// A guess prepared for block scoring: each position points at the slot of its distinct letter
+struct SimdGuess {
+    size_t length = 0;
+    size_t slotCount = 0;
+    uint8_t letters[SIMD_MAX_LENGTH];
+    uint8_t slots[SIMD_MAX_LENGTH];
+    uint8_t slotLetters[SIMD_MAX_LENGTH];
+
+    void prepare(const uint8_t* guess, size_t wordLength) {
+        length = wordLength;
+        slotCount = 0;
+        for (size_t p = 0; p < length; p++) {
+            letters[p] = guess[p];
+            size_t slot = 0;
+            while (slot < slotCount && slotLetters[slot] != guess[p]) slot++;
+            if (slot == slotCount) slotLetters[slotCount++] = guess[p];
+            slots[p] = static_cast<uint8_t>(slot);
+        }
+    }
+};
+
+// Pattern codes of one guess against the 16 answers starting at `first` of a column layout.
+// Yellow rule per lane: the k-th non-green occurrence of a guess letter is yellow while the
+// answer still has more than k-1 non-green copies of it, matching computePatternCode.
+// N as for computePatternCodeN.
+template <size_t N>
+static void computePatternBlock(const SimdGuess& guess, const uint8_t* columns, size_t stride,
+                                size_t first, uint32_t* codes) {
+    static_assert(N <= SIMD_MAX_LENGTH, "block codes are 16-bit");
+    const size_t length = N ? N : guess.length;
+    u8x16 letters[SIMD_MAX_LENGTH];
+    u8x16 green[SIMD_MAX_LENGTH];
+    for (size_t p = 0; p < length; p++) {
+        letters[p] = loadLanes(columns + p * stride + first);
+        green[p] = (u8x16)(letters[p] == splatLanes(guess.letters[p]));
+    }
+
+    // Non-green copies of each distinct guess letter in every answer
+    u8x16 available[SIMD_MAX_LENGTH];
+    u8x16 used[SIMD_MAX_LENGTH];
+    for (size_t slot = 0; slot < guess.slotCount; slot++) {
+        u8x16 letter = splatLanes(guess.slotLetters[slot]);
+        u8x16 count = splatLanes(0);
+        for (size_t p = 0; p < length; p++) {
+            count -= (u8x16)(letters[p] == letter) & ~green[p];
+        }
+        available[slot] = count;
+        used[slot] = splatLanes(0);
+    }
+
+    u8x16 state[SIMD_MAX_LENGTH];
+    for (size_t p = 0; p < length; p++) {
+        size_t slot = guess.slots[p];
+        u8x16 yellow = ~green[p] & (u8x16)(available[slot] > used[slot]);
+        used[slot] -= yellow;
+        state[p] = (green[p] & splatLanes(2)) | (yellow & splatLanes(1));
+    }
+
+    // Horner evaluation of the base-3 code, highest position first
+    if (length <= 5) {
+        u8x16 code = splatLanes(0);
+        for (size_t p = length; p-- > 0;) code = code + code + code + state[p];
+        for (size_t i = 0; i < SIMD_LANES; i++) codes[i] = code[i];
+    } else {
+        u16x16 code = __builtin_convertvector(splatLanes(0), u16x16);
+        for (size_t p = length; p-- > 0;) code = code + code + code + __builtin_convertvector(state[p], u16x16);
+        for (size_t i = 0; i < SIMD_LANES; i++) codes[i] = code[i];
+    }
+}
+#endif
+
+// Word list packed into one contiguous buffer of fixed-length rows of letter indices
+// Binary dictionary (scripts/pack-dictionaries.js): a 16-byte header, then `count` rows of
+// `stride` bytes, each holding 5-bit letter slots packed least significant bit first
+static constexpr size_t DICTIONARY_HEADER_BYTES = 16;
+static constexpr uint8_t DICTIONARY_VERSION = 1;
+static constexpr uint8_t DICTIONARY_LETTER_BITS = 5;
+
+static inline size_t dictionaryStride(size_t wordLength) {
+    return (wordLength * DICTIONARY_LETTER_BITS + 7) / 8;
+}
+
+struct DictionaryHeader {
+    size_t wordLength = 0;
+    size_t count = 0;
+    size_t stride = 0;
+
+    // Validates magic, version, bit width and that every row fits inside `bytes`
+    bool parse(const uint8_t* data, size_t bytes) {
+        if (bytes < DICTIONARY_HEADER_BYTES || std::memcmp(data, "WDLB", 4) != 0) return false;
+        if (data[4] != DICTIONARY_VERSION || data[6] != DICTIONARY_LETTER_BITS) return false;
+        wordLength = data[5];
+        count = readLE32(data + 8);
+        stride = readLE32(data + 12);
+        return wordLength > 0 && stride == dictionaryStride(wordLength) &&
+               count <= (bytes - DICTIONARY_HEADER_BYTES) / stride;
+    }
+
+    static size_t readLE32(const uint8_t* p) {
+        return static_cast<size_t>(p[0]) | static_cast<size_t>(p[1]) << 8 |
+               static_cast<size_t>(p[2]) << 16 | static_cast<size_t>(p[3]) << 24;
+    }
+};
+
+// Opening book (scripts/build-opening-tables.mjs): best first guesses plus the best second
+// guess for every feedback pattern of the leading openers. Little endian throughout:
+//   header  "WDLO", u8 version, u8 length, u16 openers, u16 follow-up openers, u16 0, u32 answers
+//   opener  word[length], f32 entropy
+//   per follow-up opener: u32 patterns, then per pattern with 3+ answers left
+//           u64 pattern code, u32 answers left, f32 entropy, word[length]
+//           (entropy -1 marks a pattern no guess could be ranked for, e.g. hard mode with
+//           every guess ruled out; its word is then the first answer left)
+static constexpr uint8_t OPENING_TABLE_VERSION = 1;
+
+static void appendLE(std::vector<uint8_t>& out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+static void appendFloat(std::vector<uint8_t>& out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    appendLE(out, bits, 4);
+}
+
+// Engine snapshot (serializeState), cached by the worker between visits so a warm start
+// restores the packed lists and precomputed tables instead of rebuilding them:
+//   header  "WDLS", u8 version, u8 flags, u16 0, u64 hash of everything after the header
+//   guesses, answers   word store sections: u32 length, u32 count, letter rows, u32 presence masks
+//   flag 1  u32 prior weight per answer
+//   flag 2  matrix answers (word store section), u32 active columns then one per answer,
+//           then the guess x matrix answer cells
+//   flag 4  u32 bytes, then the opening table
+// Bulk arrays are copied as is, in the host byte order (little endian on every target built).
+static constexpr uint8_t STATE_VERSION = 1;
+static constexpr size_t STATE_HEADER_BYTES = 16;
+static constexpr uint8_t STATE_HAS_PRIORS = 1;
+static constexpr uint8_t STATE_HAS_MATRIX = 2;
+static constexpr uint8_t STATE_HAS_OPENINGS = 4;
+
+static void appendBytes(std::vector<uint8_t>& out, const void* data, size_t bytes) {
+    const uint8_t* begin = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), begin, begin + bytes);
+}
+
+// Bounds-checked cursor over a snapshot; every read fails once the data runs out
+struct StateReader {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+
+    size_t remaining() const { return size - offset; }
+
+    bool read(void* out, size_t bytes) {
+        if (bytes > remaining()) return false;
+        if (bytes > 0) std::memcpy(out, data + offset, bytes);
+        offset += bytes;
+        return true;
+    }
+
+    bool readLE(uint64_t& value, size_t bytes) {
+        if (bytes > remaining()) return false;
+        value = 0;
+        for (size_t i = 0; i < bytes; i++) value |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+        offset += bytes;
+        return true;
+    }
+};
+
+class WordStore {
+private:
+    size_t length = 0;
+    size_t count = 0;
+    std::vector<uint8_t> letters;
+    std::vector<uint32_t> presenceMasks; // bit per letter slot present in the word
+    std::vector<uint32_t> sortedRows;    // built on first find()
+
+    // Optional column-major copy: one run per position, padded to a multiple of 16 words
+    std::vector<uint8_t> columnLetters;
+    size_t stride = 0;
+
+    bool rowLess(uint32_t a, const uint8_t* key) const {
+        return std::memcmp(row(a), key, length) < 0;
+    }
+
+public:
+    void clear() {
+        length = count = 0;
+        std::vector<uint8_t>().swap(letters);
+        std::vector<uint32_t>().swap(presenceMasks);
+        std::vector<uint32_t>().swap(sortedRows);
+        std::vector<uint8_t>().swap(columnLetters);
+        stride = 0;
+    }
+
+    // Packs a word list; the first word fixes the length and mismatched words are skipped
+    void assign(const std::vector<std::string>& words) {
+        reset(words.empty() ? 0 : words[0].length());
+        letters.reserve(words.size() * length);
+        presenceMasks.reserve(words.size());
+        for (const std::string& word : words) append(word);
+    }
+
+    // Starts an empty store of fixed-length rows for appendRow. Keeps the buffers' capacity,
+    // so a store refilled on every call stops allocating once it has held its largest list.
+    void reset(size_t wordLength) {
+        length = wordLength;
+        count = 0;
+        letters.clear();
+        presenceMasks.clear();
+        sortedRows.clear();
+        columnLetters.clear();
+    }
+
+    void appendRow(const uint8_t* letterRow, uint32_t presence) {
+        letters.insert(letters.end(), letterRow, letterRow + length);
+        presenceMasks.push_back(presence);
+        count++;
+        sortedRows.clear();
+        columnLetters.clear();
+    }
+
+    // Packs `total` fixed-stride rows of ASCII letters (any case), e.g. a Uint8Array copied into the heap
+    void assignPacked(const uint8_t* ascii, size_t total, size_t wordLength) {
+        reset(wordLength);
+        letters.resize(total * wordLength);
+        presenceMasks.resize(total);
+        for (size_t i = 0; i < total; i++) {
+            uint32_t presence = 0;
+            for (size_t p = 0; p < wordLength; p++) {
+                uint8_t index = letterIndex(static_cast<char>(ascii[i * wordLength + p]));
+                letters[i * wordLength + p] = index;
+                presence |= 1u << index;
+            }
+            presenceMasks[i] = presence;
+        }
+        count = total;
+    }
+
+    // Unpacks a binary dictionary straight into letter slots; false when the header is invalid
+    bool assignDictionary(const uint8_t* data, size_t bytes) {
+        DictionaryHeader header;
+        if (!header.parse(data, bytes)) {
+            clear();
+            return false;
+        }
+        reset(header.wordLength);
+        appendDictionaryRows(data + DICTIONARY_HEADER_BYTES, header.count);
+        return true;
+    }
+
+    // Appends rows in the binary dictionary layout (no header) for this store's length
+    void appendDictionaryRows(const uint8_t* packedRows, size_t rowCount) {
+        const size_t rowBytes = dictionaryStride(length);
+        const uint32_t mask = (1u << DICTIONARY_LETTER_BITS) - 1;
+        size_t first = count;
+        letters.resize((first + rowCount) * length);
+        presenceMasks.resize(first + rowCount);
+        for (size_t i = 0; i < rowCount; i++) {
+            const uint8_t* packed = packedRows + i * rowBytes;
+            uint8_t* letterRow = letters.data() + (first + i) * length;
+            uint32_t presence = 0;
+            for (size_t p = 0; p < length; p++) {
+                size_t bit = p * DICTIONARY_LETTER_BITS;
+                size_t byte = bit >> 3;
+                uint32_t window = packed[byte];
+                if (byte + 1 < rowBytes) window |= static_cast<uint32_t>(packed[byte + 1]) << 8;
+                uint8_t index = static_cast<uint8_t>(std::min<uint32_t>((window >> (bit & 7)) & mask, 26));
+                letterRow[p] = index;
+                presence |= 1u << index;
+            }
+            presenceMasks[first + i] = presence;
+        }
+        count += rowCount;
+        sortedRows.clear();
+        columnLetters.clear();
+    }
+
+    bool append(const std::string& word) {
+        if (count == 0 && letters.empty()) length = word.length();
+        if (word.length() != length) return false;
+        uint32_t presence = 0;
+        for (char c : word) {
+            uint8_t index = letterIndex(c);
+            letters.push_back(index);
+            presence |= 1u << index;
+        }
+        presenceMasks.push_back(presence);
+        count++;
+        sortedRows.clear();
+        columnLetters.clear();
+        return true;
+    }
+
+    // Builds the column layout; padding lanes hold 0xFF, which never matches a letter
+    void buildColumns() {
+        if (hasColumns()) return;
+        stride = (count + 15) / 16 * 16;
+        columnLetters.assign(length * stride, 0xFF);
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t* letterRow = row(i);
+            for (size_t p = 0; p < length; p++) columnLetters[p * stride + i] = letterRow[p];
+        }
+    }
+
+    bool hasColumns() const { return count > 0 && !columnLetters.empty(); }
+    const uint8_t* columns() const { return columnLetters.data(); }
+    size_t columnStride() const { return stride; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t wordLength() const { return length; }
+    size_t byteSize() const {
+        return letters.size() + presenceMasks.size() * sizeof(uint32_t) + columnLetters.size();
+    }
+    const uint8_t* row(size_t index) const { return letters.data() + index * length; }
+    uint32_t presence(size_t index) const { return presenceMasks[index]; }
+
+    std::string word(size_t index) const {
+        std::string result(length, ' ');
+        const uint8_t* letterRow = row(index);
+        for (size_t i = 0; i < length; i++) result[i] = letterChar(letterRow[i]);
+        return result;
+    }
+
+    // Row index of a word, or -1 when it is not in the store
+    int find(const std::string& word) {
+        if (word.length() != length || count == 0) return -1;
+        if (sortedRows.size() != count) {
+            sortedRows.resize(count);
+            for (size_t i = 0; i < count; i++) sortedRows[i] = static_cast<uint32_t>(i);
+            std::sort(sortedRows.begin(), sortedRows.end(), [this](uint32_t a, uint32_t b) {
+                return std::memcmp(row(a), row(b), length) < 0;
+            });
+        }
+        uint8_t key[64];
+        std::vector<uint8_t> longKey;
+        uint8_t* packed = key;
+        if (length > sizeof(key)) {
+            longKey.resize(length);
+            packed = longKey.data();
+        }
+        for (size_t i = 0; i < length; i++) packed[i] = letterIndex(word[i]);
+
+        auto it = std::lower_bound(sortedRows.begin(), sortedRows.end(), packed,
+                                   [this](uint32_t a, const uint8_t* k) { return rowLess(a, k); });
+        if (it == sortedRows.end() || std::memcmp(row(*it), packed, length) != 0) return -1;
+        return static_cast<int>(*it);
+    }
+
+    bool sameWords(const WordStore& other) const {
+        return length == other.length && count == other.count && letters == other.letters;
+    }
+
+    // Word store section of a snapshot: the rows and presence masks as they are held
+    void appendState(std::vector<uint8_t>& out) const {
+        appendLE(out, length, 4);
+        appendLE(out, count, 4);
+        appendBytes(out, letters.data(), letters.size());
+        appendBytes(out, presenceMasks.data(), presenceMasks.size() * sizeof(uint32_t));
+    }
+
+    // Reads a section written by appendState; false (and an empty store) when it is malformed
+    bool restoreState(StateReader& reader) {
+        uint64_t wordLength = 0;
+        uint64_t total = 0;
+        bool valid = reader.readLE(wordLength, 4) && reader.readLE(total, 4) && wordLength <= 255 &&
+                     total <= reader.remaining() / (wordLength + sizeof(uint32_t));
+        if (valid) {
+            reset(wordLength);
+            letters.resize(total * wordLength);
+            presenceMasks.resize(total);
+            valid = reader.read(letters.data(), letters.size()) &&
+                    reader.read(presenceMasks.data(), presenceMasks.size() * sizeof(uint32_t));
+            for (size_t i = 0; valid && i < letters.size(); i++) valid = letters[i] < ALPHABET_SLOTS;
+        }
+        if (!valid) {
+            clear();
+            return false;
+        }
+        count = total;
+        return true;
+    }
+};
+
+// Subset of a WordStore's rows, one bit per row
+class CandidateSet {
+private:
+    std::vector<uint64_t> bits;
+    size_t universe = 0;
+    size_t population = 0;
+
+public:
+    // Selects every row of a store with `size` rows
+    void fill(size_t size) {
+        universe = population = size;
+        bits.assign((size + 63) / 64, ~0ull);
+        if (size % 64) bits.back() = (1ull << (size % 64)) - 1;
+    }
+
+    // Selects no row of a store with `size` rows
+    void clear(size_t size) {
+        universe = size;
+        population = 0;
+        bits.assign((size + 63) / 64, 0);
+    }
+
+    // Selects exactly the listed rows of a store with `size` rows
+    void select(size_t size, const std::vector<uint32_t>& rows) {
+        universe = size;
+        bits.assign((size + 63) / 64, 0);
+        for (uint32_t row : rows) bits[row / 64] |= 1ull << (row % 64);
+        population = rows.size();
+    }
+
+    size_t size() const { return population; }
+    size_t universeSize() const { return universe; }
+    bool full() const { return population == universe; }
+    bool test(size_t index) const { return (bits[index / 64] >> (index % 64)) & 1ull; }
+
+    void insert(size_t index) {
+        uint64_t bit = 1ull << (index % 64);
+        if (!(bits[index / 64] & bit)) population++;
+        bits[index / 64] |= bit;
+    }
+
+    // Set algebra with another set over the same store, recounting with popcount in the same pass
+    void intersect(const CandidateSet& other) {
+        combine(other, [](uint64_t a, uint64_t b) { return a & b; });
+    }
+
+    void unite(const CandidateSet& other) {
+        combine(other, [](uint64_t a, uint64_t b) { return a | b; });
+    }
+
+    void subtract(const CandidateSet& other) {
+        combine(other, [](uint64_t a, uint64_t b) { return a & ~b; });
+    }
+
+    template <typename Op>
+    void combine(const CandidateSet& other, Op op) {
+        population = 0;
+        for (size_t word = 0; word < bits.size(); word++) {
+            bits[word] = op(bits[word], other.bits[word]);
+            population += static_cast<size_t>(__builtin_popcountll(bits[word]));
+        }
+    }
+
+    size_t byteSize() const { return bits.size() * sizeof(uint64_t); }
+
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (size_t word = 0; word < bits.size(); word++) {
+            for (uint64_t mask = bits[word]; mask != 0; mask &= mask - 1) {
+                fn(word * 64 + static_cast<size_t>(__builtin_ctzll(mask)));
+            }
+        }
+    }
+
+    // Clears every row for which keep(row) is false
+    template <typename Pred>
+    void retain(Pred keep) {
+        population = 0;
+        for (size_t word = 0; word < bits.size(); word++) {
+            uint64_t kept = 0;
+            for (uint64_t mask = bits[word]; mask != 0; mask &= mask - 1) {
+                int bit = __builtin_ctzll(mask);
+                if (keep(word * 64 + bit)) kept |= 1ull << bit;
+            }
+            bits[word] = kept;
+            population += static_cast<size_t>(__builtin_popcountll(kept));
+        }
+    }
+};
+
+// Board constraints compiled into per-position allowed-letter masks plus letter count bounds,
+// so a word is accepted with a few AND/compare ops. A gray letter that is also green or
+// yellow caps the count at the known copies instead of rejecting every word containing it.
+// The constraint shape of filterWords: the green letter per position ("" when unknown),
+// letters known to be in the word with the positions they are not in, and absent letters
+struct YellowLetter {
+    std::string letter;
+    std::vector<int> excludedPositions;
+};
+
+struct WordConstraints {
+    std::vector<std::string> knownPositions;
+    std::vector<YellowLetter> yellowLetters;
+    std::vector<std::string> grayLetters;
+};
+
+class CompiledConstraints {
+private:
+    static constexpr uint32_t ALL_LETTERS = (1u << ALPHABET_SLOTS) - 1;
+
+    size_t length = 0;
+    std::vector<uint32_t> allowed;   // per position
+    std::vector<int> greens;         // letter fixed at each position, or -1
+    uint32_t required = 0;           // letters that must appear
+    uint32_t excluded = 0;           // letters that must not appear
+    uint32_t counted = 0;            // letters whose copies need counting
+    uint32_t repeatedHints = 0;      // letters revealed more than once
+    uint8_t greenCount[ALPHABET_SLOTS] = {0};
+    uint8_t yellowCount[ALPHABET_SLOTS] = {0};
+    uint8_t minCount[ALPHABET_SLOTS] = {0};
+    uint8_t maxCount[ALPHABET_SLOTS] = {0};
+    uint32_t grays = 0;
+
+public:
+    void reset(size_t wordLength) {
+        length = wordLength;
+        allowed.assign(length, ALL_LETTERS);
+        greens.assign(length, -1);
+        required = excluded = counted = grays = repeatedHints = 0;
+        std::fill(std::begin(greenCount), std::end(greenCount), 0);
+        std::fill(std::begin(yellowCount), std::end(yellowCount), 0);
+    }
+
+    void addGreen(size_t position, uint8_t letter) {
+        if (position >= length || greens[position] >= 0) return;
+        greens[position] = letter;
+        allowed[position] = 1u << letter;
+        greenCount[letter]++;
+    }
+
+    void addYellow(uint8_t letter, const std::vector<int>& excludedPositions) {
+        yellowCount[letter]++;
+        for (int position : excludedPositions) {
+            if (position >= 0 && static_cast<size_t>(position) < length) {
+                allowed[position] &= ~(1u << letter);
+            }
+        }
+    }
+
+    void addGray(uint8_t letter) {
+        grays |= 1u << letter;
+    }
+
+    // Derives count bounds and folds them into the position masks where possible
+    void finalize() {
+        for (int letter = 0; letter < ALPHABET_SLOTS; letter++) {
+            uint32_t bit = 1u << letter;
+            minCount[letter] = std::max(greenCount[letter], yellowCount[letter]);
+            maxCount[letter] = (grays & bit) ? minCount[letter] : static_cast<uint8_t>(std::min<size_t>(length, 255));
+            if (minCount[letter] > 0) required |= bit;
+            if (minCount[letter] > 1) repeatedHints |= bit;
+
+            if (maxCount[letter] == 0) {
+                excluded |= bit;
+            }
+            if (maxCount[letter] == greenCount[letter]) {
+                // Every copy is already placed: no other position may hold the letter
+                for (size_t p = 0; p < length; p++) {
+                    if (greens[p] != letter) allowed[p] &= ~bit;
+                }
+            } else if (maxCount[letter] < length || minCount[letter] > std::max<uint8_t>(greenCount[letter], 1)) {
+                counted |= bit;
+            }
+        }
+    }
+
+    void compile(size_t wordLength, const WordConstraints& input) {
+        reset(wordLength);
+        for (size_t i = 0; i < input.knownPositions.size(); i++) {
+            const std::string& pos = input.knownPositions[i];
+            if (!pos.empty()) addGreen(i, letterIndex(pos[0]));
+        }
+        for (const YellowLetter& yellow : input.yellowLetters) {
+            if (!yellow.letter.empty()) addYellow(letterIndex(yellow.letter[0]), yellow.excludedPositions);
+        }
+        for (const std::string& letter : input.grayLetters) {
+            if (!letter.empty()) addGray(letterIndex(letter[0]));
+        }
+        finalize();
+    }
+
+    size_t wordLength() const { return length; }
+    int greenAt(size_t position) const { return greens[position]; }
+    uint32_t excludedLetters() const { return excluded; }
+    uint32_t allowedAt(size_t position) const { return allowed[position]; }
+    size_t minCopies(int letter) const { return minCount[letter]; }
+    size_t maxCopies(int letter) const { return maxCount[letter]; }
+
+    bool matches(const uint8_t* word, uint32_t presence) const {
+        return matchesN<0>(word, presence);
+    }
+
+    // matches() for words of N letters (N = 0: the compiled length)
+    template <size_t N>
+    bool matchesN(const uint8_t* word, uint32_t presence) const {
+        const size_t n = N ? N : length;
+        if ((presence & required) != required || (presence & excluded) != 0) return false;
+        for (size_t p = 0; p < n; p++) {
+            if (!((allowed[p] >> word[p]) & 1u)) return false;
+        }
+        if (counted & presence) {
+            uint8_t counts[ALPHABET_SLOTS] = {0};
+            for (size_t p = 0; p < n; p++) counts[word[p]]++;
+            for (uint32_t bits = counted; bits != 0; bits &= bits - 1) {
+                int letter = __builtin_ctz(bits);
+                if (counts[letter] < minCount[letter] || counts[letter] > maxCount[letter]) return false;
+            }
+        }
+        return true;
+    }
+
+    // Hard-mode guess rule: greens stay in place and every revealed letter is reused at least
+    // as often as revealed. Gray letters and yellow positions may be reused, as in the game.
+    bool satisfiesHints(const uint8_t* word, uint32_t presence) const {
+        if ((presence & required) != required) return false;
+        for (size_t p = 0; p < length; p++) {
+            if (greens[p] >= 0 && word[p] != greens[p]) return false;
+        }
+        if (repeatedHints) {
+            uint8_t counts[ALPHABET_SLOTS] = {0};
+            for (size_t p = 0; p < length; p++) counts[word[p]]++;
+            for (uint32_t bits = repeatedHints; bits != 0; bits &= bits - 1) {
+                int letter = __builtin_ctz(bits);
+                if (counts[letter] < minCount[letter]) return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Posting bitsets over a word store: the rows holding each letter at each position, and the
+// rows holding at least k copies of each letter. Compiled constraints resolve to their matching
+// rows with word-wide AND/ANDNOT passes, one per position and per bounded letter, and the match
+// count falls out of the popcounts without visiting a word.
+class PostingIndex {
+private:
+    size_t length = 0;
+    size_t rows = 0;
+    bool built = false;
+    std::vector<CandidateSet> positions;            // [position * ALPHABET_SLOTS + letter]
+    std::vector<std::vector<CandidateSet>> copies;  // [letter][k - 1]: rows with k or more copies
+    CandidateSet letterUnion;
+
+public:
+    void clear() {
+        length = rows = 0;
+        built = false;
+        std::vector<CandidateSet>().swap(positions);
+        std::vector<std::vector<CandidateSet>>().swap(copies);
+    }
+
+    bool ready() const { return built; }
+    size_t rowCount() const { return rows; }
+
+    void build(const WordStore& words) {
+        length = words.wordLength();
+        rows = words.size();
+        positions.assign(length * ALPHABET_SLOTS, CandidateSet());
+        for (CandidateSet& posting : positions) posting.clear(rows);
+        copies.assign(ALPHABET_SLOTS, std::vector<CandidateSet>());
+        for (size_t i = 0; i < rows; i++) {
+            const uint8_t* letterRow = words.row(i);
+            uint8_t counts[ALPHABET_SLOTS] = {0};
+            for (size_t p = 0; p < length; p++) {
+                uint8_t letter = letterRow[p];
+                positions[p * ALPHABET_SLOTS + letter].insert(i);
+                std::vector<CandidateSet>& levels = copies[letter];
+                if (levels.size() <= counts[letter]) {
+                    levels.emplace_back();
+                    levels.back().clear(rows);
+                }
+                levels[counts[letter]++].insert(i);
+            }
+        }
+        built = true;
+    }
+
+    // Rows matching `compiled`, exactly as CompiledConstraints::matches decides them
+    void resolve(const CompiledConstraints& compiled, CandidateSet& matches) {
+        matches.fill(rows);
+        if (compiled.wordLength() != length) {
+            matches.clear(rows);
+            return;
+        }
+        const uint32_t allLetters = (1u << ALPHABET_SLOTS) - 1;
+        for (size_t p = 0; p < length && matches.size() > 0; p++) {
+            uint32_t allowed = compiled.allowedAt(p) & allLetters;
+            uint32_t disallowed = ~allowed & allLetters;
+            const CandidateSet* posting = &positions[p * ALPHABET_SLOTS];
+            if (disallowed == 0) continue;
+            // Whichever side has fewer letters: AND with the union of the allowed ones, or
+            // ANDNOT each disallowed one
+            if (__builtin_popcount(allowed) == 1) {
+                matches.intersect(posting[__builtin_ctz(allowed)]);
+            } else if (__builtin_popcount(allowed) < __builtin_popcount(disallowed)) {
+                letterUnion.clear(rows);
+                for (uint32_t bits = allowed; bits != 0; bits &= bits - 1) {
+                    if (posting[__builtin_ctz(bits)].size() > 0) letterUnion.unite(posting[__builtin_ctz(bits)]);
+                }
+                matches.intersect(letterUnion);
+            } else {
+                for (uint32_t bits = disallowed; bits != 0; bits &= bits - 1) {
+                    if (posting[__builtin_ctz(bits)].size() > 0) matches.subtract(posting[__builtin_ctz(bits)]);
+                }
+            }
+        }
+        for (int letter = 0; letter < ALPHABET_SLOTS && matches.size() > 0; letter++) {
+            const std::vector<CandidateSet>& levels = copies[letter];
+            size_t least = compiled.minCopies(letter);
+            size_t most = compiled.maxCopies(letter);
+            if (least > levels.size()) {
+                matches.clear(rows);
+            } else if (least > 0) {
+                matches.intersect(levels[least - 1]);
+            }
+            if (most < levels.size() && matches.size() > 0) {
+                matches.subtract(levels[most]);
+            }
+        }
+    }
+
+    size_t byteSize() const {
+        size_t bytes = letterUnion.byteSize();
+        for (const CandidateSet& posting : positions) bytes += posting.byteSize();
+        for (const std::vector<CandidateSet>& levels : copies) {
+            for (const CandidateSet& level : levels) bytes += level.byteSize();
+        }
+        return bytes;
+    }
+};
+
+// Pattern frequency counts for one guess. Codes up to 5 letters use an inline 243-entry
+// array, up to 10 letters a flat array kept between calls, beyond that an open-addressed table.
+class PatternHistogram {
+private:
+    static constexpr size_t INLINE_BUCKETS = 243;     // 3^5
+    static constexpr uint64_t DENSE_BUCKETS = 59049;  // 3^10
+    static constexpr PatternCode EMPTY_SLOT = ~static_cast<PatternCode>(0);
+
+    enum class Mode { Inline, Dense, Sparse };
+    Mode mode = Mode::Inline;
+    uint32_t inlineCounts[INLINE_BUCKETS] = {0};
+    std::vector<uint32_t> denseCounts;
+    std::vector<PatternCode> sparseKeys;
+    std::vector<uint32_t> sparseCounts;
+    size_t sparseMask = 0;
+    std::vector<uint32_t> touched;
+    uint64_t samples = 0; // total weight added
+
+    uint32_t* countsFor(Mode m) {
+        return m == Mode::Inline ? inlineCounts : m == Mode::Dense ? denseCounts.data() : sparseCounts.data();
+    }
+
+    void addCounted(uint32_t* counts, PatternCode code, uint32_t weight) {
+        if (counts[code] == 0) touched.push_back(static_cast<uint32_t>(code));
+        counts[code] += weight;
+    }
+
+    void addSparse(PatternCode code, uint32_t weight) {
+        size_t slot = static_cast<size_t>((code * 0x9E3779B97F4A7C15ull) >> 32) & sparseMask;
+        while (sparseKeys[slot] != code) {
+            if (sparseKeys[slot] == EMPTY_SLOT) {
+                sparseKeys[slot] = code;
+                touched.push_back(static_cast<uint32_t>(slot));
+                break;
+            }
+            slot = (slot + 1) & sparseMask;
+        }
+        sparseCounts[slot] += weight;
+    }
+
+public:
+    // Prepares for a new guess; expectedSamples sizes the sparse table
+    void reset(size_t wordLength, size_t expectedSamples) {
+        uint32_t* counts = countsFor(mode);
+        for (uint32_t slot : touched) {
+            counts[slot] = 0;
+            if (mode == Mode::Sparse) sparseKeys[slot] = EMPTY_SLOT;
+        }
+        touched.clear();
+        samples = 0;
+
+        uint64_t space = patternSpace(wordLength);
+        if (space <= INLINE_BUCKETS) {
+            mode = Mode::Inline;
+        } else if (space <= DENSE_BUCKETS) {
+            mode = Mode::Dense;
+            if (denseCounts.size() < space) denseCounts.assign(space, 0);
+        } else {
+            mode = Mode::Sparse;
+            size_t capacity = 16;
+            while (capacity < expectedSamples * 2) capacity <<= 1;
+            if (sparseKeys.size() < capacity) {
+                sparseKeys.assign(capacity, EMPTY_SLOT);
+                sparseCounts.assign(capacity, 0);
+            }
+            sparseMask = sparseKeys.size() - 1;
+        }
+    }
+
+    // `weight` is the answer's quantized prior; the entropy is then over prior-weighted mass
+    void add(PatternCode code, uint32_t weight = 1) {
+        samples += weight;
+        if (mode == Mode::Sparse) {
+            addSparse(code, weight);
+            return;
+        }
+        addCounted(countsFor(mode), code, weight);
+    }
+
+    // add() for codes of N-letter words, with the mode reset(N, ...) picks resolved at compile time
+    template <size_t N>
+    void addN(PatternCode code, uint32_t weight = 1) {
+        if constexpr (N == 0) {
+            add(code, weight);
+        } else if constexpr (patternSpace(N) <= INLINE_BUCKETS) {
+            samples += weight;
+            addCounted(inlineCounts, code, weight);
+        } else if constexpr (patternSpace(N) <= DENSE_BUCKETS) {
+            samples += weight;
+            addCounted(denseCounts.data(), code, weight);
+        } else {
+            samples += weight;
+            addSparse(code, weight);
+        }
+    }
+
+    // Shannon entropy: H = -Σ p(x) * log₂(p(x))
+    double entropy() {
+        const uint32_t* counts = countsFor(mode);
+        double entropy = 0.0;
+        double totalAnswers = static_cast<double>(samples);
+        for (uint32_t slot : touched) {
+            double probability = counts[slot] / totalAnswers;
+            entropy -= probability * std::log2(probability);
+        }
+        return entropy;
+    }
+};
+
+// Precomputed guess x answer table of pattern codes.
+// Cells are uint8 up to 5 letters (3^5 = 243), uint16 up to 10 and uint32 up to 20.
+class PatternMatrix {
+private:
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t cellBytes = 0;
+    std::vector<uint8_t> cells;
+
+public:
+    static constexpr size_t MAX_WORD_LENGTH = 20;
+
+    static size_t cellBytesFor(size_t wordLength) {
+        if (wordLength <= 5) return 1;
+        if (wordLength <= 10) return 2;
+        if (wordLength <= MAX_WORD_LENGTH) return 4;
+        return 0;
+    }
+
+    static uint64_t bytesRequired(size_t rowCount, size_t colCount, size_t wordLength) {
+        return static_cast<uint64_t>(rowCount) * colCount * cellBytesFor(wordLength);
+    }
+
+    void clear() {
+        rows = cols = cellBytes = 0;
+        std::vector<uint8_t>().swap(cells);
+    }
+
+    bool empty() const { return cells.empty(); }
+    size_t rowCount() const { return rows; }
+    size_t colCount() const { return cols; }
+    size_t byteSize() const { return cells.size(); }
+
+    void resize(size_t rowCount, size_t colCount, size_t wordLength) {
+        rows = rowCount;
+        cols = colCount;
+        cellBytes = cellBytesFor(wordLength);
+        cells.assign(rows * cols * cellBytes, 0);
+    }
+
+    void set(size_t row, size_t col, uint32_t code) {
+        size_t offset = (row * cols + col) * cellBytes;
+        switch (cellBytes) {
+            case 1: cells[offset] = static_cast<uint8_t>(code); break;
+            case 2: reinterpret_cast<uint16_t*>(cells.data())[offset / 2] = static_cast<uint16_t>(code); break;
+            default: reinterpret_cast<uint32_t*>(cells.data())[offset / 4] = code; break;
+        }
+    }
+
+    size_t cellSize() const { return cellBytes; }
+
+    // Raw cells, row major, for snapshots
+    const uint8_t* cellData() const { return cells.data(); }
+    uint8_t* cellData() { return cells.data(); }
+
+    // Row `row` as an array of cellSize()-byte codes
+    template <typename Cell>
+    const Cell* rowCells(size_t row) const {
+        return reinterpret_cast<const Cell*>(cells.data()) + row * cols;
+    }
+
+    uint32_t at(size_t row, size_t col) const {
+        size_t index = row * cols + col;
+        switch (cellBytes) {
+            case 1: return cells[index];
+            case 2: return reinterpret_cast<const uint16_t*>(cells.data())[index];
+            default: return reinterpret_cast<const uint32_t*>(cells.data())[index];
+        }
+    }
+};
+
+// Fallback for guess lists whose full matrix is over budget: matrix rows restricted to a base
+// set of answer columns (the candidates when it was last rebased), held in tiles of TILE_ROWS
+// consecutive guesses under a byte budget. A row is computed into its tile the second time a
+// ranking asks for it, so one-off scores never pay for a fill; the least recently used tile is
+// evicted for room, but never one already used by the current pass: once every cached tile
+// belongs to it, further rows are scored directly instead of thrashing. Workers share the cache
+// under a lock; a row another worker is filling is scored directly too.
+class PatternTileCache {
+public:
+    static constexpr size_t TILE_ROWS = 64;
+    static constexpr uint32_t NO_COLUMN = UINT32_MAX;
+
+private:
+    enum RowState : uint8_t { Unseen, Seen, Filling, Ready };
+
+    struct Tile {
+        PatternMatrix codes;
+        uint64_t pass = 0;
+        std::list<uint32_t>::iterator recent;
+    };
+
+    WordStore base;                       // answers of the columns, in column order
+    std::vector<uint32_t> columns;        // per possibleAnswers row: its column, or NO_COLUMN
+    std::vector<uint8_t> rowStates;       // per guess
+    std::vector<std::unique_ptr<Tile>> tiles; // per TILE_ROWS guesses
+    std::list<uint32_t> recent;           // cached tile indices, most recently used first
+    uint64_t budget = 0;
+    uint64_t bytes = 0;
+    uint64_t pass = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;                  // rows scored directly or filled
+#ifdef ENTROPY_THREADS
+    std::mutex mutex;
+    void lock() { mutex.lock(); }
+    void unlock() { mutex.unlock(); }
+#else
+    void lock() {}
+    void unlock() {}
+#endif
+
+    uint64_t tileBytes() const {
+        return PatternMatrix::bytesRequired(TILE_ROWS, base.size(), base.wordLength()) + sizeof(Tile);
+    }
+
+    void erase(uint32_t index) {
+        bytes -= tileBytes();
+        recent.erase(tiles[index]->recent);
+        tiles[index].reset();
+        size_t first = static_cast<size_t>(index) * TILE_ROWS;
+        for (size_t row = first; row < std::min(first + TILE_ROWS, rowStates.size()); row++) {
+            if (rowStates[row] == Ready) rowStates[row] = Seen;
+        }
+    }
+
+    // Drops least recently used tiles from earlier passes until `extra` more bytes fit
+    bool makeRoom(uint64_t extra) {
+        while (bytes + extra > budget && !recent.empty()) {
+            uint32_t oldest = recent.back();
+            if (tiles[oldest]->pass == pass) return false;
+            erase(oldest);
+        }
+        return bytes + extra <= budget;
+    }
+
+    Tile* tileFor(size_t row) {
+        uint32_t index = static_cast<uint32_t>(row / TILE_ROWS);
+        Tile* tile = tiles[index].get();
+        if (!tile) {
+            if (!makeRoom(tileBytes())) return nullptr;
+            tiles[index].reset(new Tile());
+            tile = tiles[index].get();
+            size_t first = static_cast<size_t>(index) * TILE_ROWS;
+            tile->codes.resize(std::min(TILE_ROWS, rowStates.size() - first), base.size(), base.wordLength());
+            recent.push_front(index);
+            tile->recent = recent.begin();
+            bytes += tileBytes();
+        } else {
+            recent.splice(recent.begin(), recent, tile->recent);
+        }
+        tile->pass = pass;
+        return tile;
+    }
+
+public:
+    bool active() const { return !base.empty(); }
+    size_t columnCount() const { return base.size(); }
+    uint32_t columnOf(size_t answerRow) const { return columns[answerRow]; }
+    const WordStore& answers() const { return base; }
+    uint64_t byteSize() const { return bytes; }
+    uint64_t hitCount() const { return hits; }
+    uint64_t missCount() const { return misses; }
+
+    void reset() {
+        base.clear();
+        columns.clear();
+        rowStates.clear();
+        tiles.clear();
+        recent.clear();
+        bytes = 0;
+    }
+
+    // True when every candidate has a column
+    bool covers(const CandidateSet& candidates) const {
+        if (!active() || columns.size() != candidates.universeSize()) return false;
+        bool covered = true;
+        candidates.forEach([&](size_t row) { covered = covered && columns[row] != NO_COLUMN; });
+        return covered;
+    }
+
+    // New base columns (the candidates) for `guessCount` guesses; false, leaving the cache
+    // inactive, when a single tile would exceed the budget
+    bool rebase(const WordStore& answers, const CandidateSet& candidates, size_t guessCount, bool simd) {
+        reset();
+        if (PatternMatrix::bytesRequired(TILE_ROWS, candidates.size(), answers.wordLength()) + sizeof(Tile) > budget) {
+            return false;
+        }
+        base.reset(answers.wordLength());
+        columns.assign(answers.size(), NO_COLUMN);
+        candidates.forEach([&](size_t row) {
+            columns[row] = static_cast<uint32_t>(base.size());
+            base.appendRow(answers.row(row), answers.presence(row));
+        });
+        if (simd) base.buildColumns();
+        rowStates.assign(guessCount, Unseen);
+        tiles.resize((guessCount + TILE_ROWS - 1) / TILE_ROWS);
+        return true;
+    }
+
+    void setBudget(uint64_t maxBytes) {
+        budget = maxBytes;
+        pass++;
+        makeRoom(0);
+        if (active() && tileBytes() > budget) reset();
+    }
+
+    // Called on the calling thread before each ranking pass
+    void beginPass() {
+        pass++;
+    }
+
+    // The tile holding guess `row`, or nullptr to score the row directly. `fill` is set when
+    // the caller must compute the row into the tile and then publish it.
+    const PatternMatrix* claim(size_t row, bool& fill) {
+        fill = false;
+        lock();
+        const PatternMatrix* codes = nullptr;
+        uint8_t state = rowStates[row];
+        if (state == Ready) {
+            codes = &tileFor(row)->codes;
+            hits++;
+        } else {
+            misses++;
+            if (state == Unseen) {
+                rowStates[row] = Seen;
+            } else if (state == Seen) {
+                if (Tile* tile = tileFor(row)) {
+                    rowStates[row] = Filling;
+                    codes = &tile->codes;
+                    fill = true;
+                }
+            }
+        }
+        unlock();
+        return codes;
+    }
+
+    // Row `row` of its tile, for the worker that claimed it with fill set
+    PatternMatrix& fillTarget(size_t row) {
+        return tiles[row / TILE_ROWS]->codes;
+    }
+
+    void publish(size_t row) {
+        lock();
+        rowStates[row] = Ready;
+        unlock();
+    }
+
+    void resetCounters() { hits = misses = 0; }
+};
+
+// Length-specialized loops. A session is fixed to one word length, so the calculator takes its
+// kernels from a table once per word list: entries 1-31 cover the shipped dictionaries with
+// unrolled code (up to 5 letters the histogram is the inline 243-entry array, past 10 the
+// open-addressed table), and entry 0 is the run-time-length fallback for anything else.
+static constexpr size_t MAX_SPECIALIZED_LENGTH = 31;
+
+struct LengthKernels {
+    // Adds the codes of `guess` against every answer to a histogram reset for this length,
+    // each counted with its weight when `weights` (parallel to the answers) is given
+    void (*scoreRow)(const uint8_t* guess, const WordStore& answers, const uint32_t* weights, bool simd,
+                     PatternHistogram& histogram);
+    void (*fillMatrixRow)(const uint8_t* guess, const WordStore& answers, bool simd, PatternMatrix& matrix,
+                          size_t row);
+    // Writes the code of `guess` against each answer to `codes` (room for every answer)
+    void (*patternRow)(const uint8_t* guess, const WordStore& answers, bool simd, PatternCode* codes);
+    // Writes the indices of matching words to `matches` (room for every word); returns the count
+    size_t (*filterRows)(const WordStore& words, const CompiledConstraints& compiled, bool simd, uint32_t* matches);
+};
+
+// Calls emit(answerIndex, code) for `guess` against every answer
+template <size_t N, typename Emit>
+static void forEachPattern(const uint8_t* guess, const WordStore& answers, bool simd, const Emit& emit) {
+    size_t length = answers.wordLength();
+    size_t answerCount = answers.size();
+#ifdef ENTROPY_SIMD
+    if constexpr (N <= SIMD_MAX_LENGTH) {
+        if (simd) {
+            SimdGuess plan;
+            plan.prepare(guess, length);
+            uint32_t codes[SIMD_LANES];
+            for (size_t first = 0; first < answerCount; first += SIMD_LANES) {
+                computePatternBlock<N>(plan, answers.columns(), answers.columnStride(), first, codes);
+                size_t lanes = std::min(SIMD_LANES, answerCount - first);
+                for (size_t lane = 0; lane < lanes; lane++) emit(first + lane, codes[lane]);
+            }
+            return;
+        }
+    }
+#endif
+    (void)simd;
+    for (size_t a = 0; a < answerCount; a++) {
+        emit(a, computePatternCodeN<N>(guess, answers.row(a), length));
+    }
+}
+
+template <size_t N>
+static void scoreRowN(const uint8_t* guess, const WordStore& answers, const uint32_t* weights, bool simd,
+                      PatternHistogram& histogram) {
+    if (weights) {
+        forEachPattern<N>(guess, answers, simd, [&](size_t a, PatternCode code) { histogram.addN<N>(code, weights[a]); });
+    } else {
+        forEachPattern<N>(guess, answers, simd, [&](size_t, PatternCode code) { histogram.addN<N>(code); });
+    }
+}
+
+template <size_t N>
+static void fillMatrixRowN(const uint8_t* guess, const WordStore& answers, bool simd, PatternMatrix& matrix,
+                           size_t row) {
+    if constexpr (N <= PatternMatrix::MAX_WORD_LENGTH) {
+        forEachPattern<N>(guess, answers, simd, [&](size_t a, PatternCode code) {
+            matrix.set(row, a, static_cast<uint32_t>(code));
+        });
+    } else {
+        // buildMatrix never takes words this long
+        (void)guess; (void)answers; (void)simd; (void)matrix; (void)row;
+    }
+}
+
+template <size_t N>
+static void patternRowN(const uint8_t* guess, const WordStore& answers, bool simd, PatternCode* codes) {
+    forEachPattern<N>(guess, answers, simd, [&](size_t a, PatternCode code) { codes[a] = code; });
+}
+
+template <size_t N>
+static size_t filterRowsN(const WordStore& words, const CompiledConstraints& compiled, bool simd,
+                          uint32_t* matches) {
+    const size_t length = N ? N : words.wordLength();
+    size_t found = 0;
+#ifdef ENTROPY_SIMD
+    // Vectorized prefilter of greens and excluded letters, 16 words per instruction,
+    // then the mask check on the surviving lanes
+    if (simd) {
+        const uint8_t* columns = words.columns();
+        size_t stride = words.columnStride();
+        uint8_t excludedLetters[ALPHABET_SLOTS];
+        size_t excludedCount = 0;
+        for (uint32_t bits = compiled.excludedLetters(); bits != 0; bits &= bits - 1) {
+            excludedLetters[excludedCount++] = static_cast<uint8_t>(__builtin_ctz(bits));
+        }
+
+        for (size_t first = 0; first < words.size(); first += SIMD_LANES) {
+            u8x16 valid = splatLanes(0xFF);
+            for (size_t p = 0; p < length; p++) {
+                u8x16 letters = loadLanes(columns + p * stride + first);
+                int green = compiled.greenAt(p);
+                if (green >= 0) {
+                    valid &= (u8x16)(letters == splatLanes(static_cast<uint8_t>(green)));
+                    continue;
+                }
+                for (size_t e = 0; e < excludedCount; e++) {
+                    valid &= ~(u8x16)(letters == splatLanes(excludedLetters[e]));
+                }
+            }
+
+            size_t lanes = std::min(SIMD_LANES, words.size() - first);
+            for (size_t lane = 0; lane < lanes; lane++) {
+                size_t index = first + lane;
+                if (valid[lane] && compiled.matchesN<N>(words.row(index), words.presence(index))) {
+                    matches[found++] = static_cast<uint32_t>(index);
+                }
+            }
+        }
+        return found;
+    }
+#endif
+    (void)simd;
+    for (size_t index = 0; index < words.size(); index++) {
+        if (compiled.matchesN<N>(words.row(index), words.presence(index))) {
+            matches[found++] = static_cast<uint32_t>(index);
+        }
+    }
+    return found;
+}
+
+template <size_t... N>
+static const LengthKernels* buildKernelTable(std::index_sequence<N...>) {
+    static const LengthKernels table[] = {{&scoreRowN<N>, &fillMatrixRowN<N>, &patternRowN<N>, &filterRowsN<N>}...};
+    return table;
+}
+
+static const LengthKernels& kernelsFor(size_t wordLength) {
+    static const LengthKernels* table = buildKernelTable(std::make_index_sequence<MAX_SPECIALIZED_LENGTH + 1>());
+    return table[wordLength <= MAX_SPECIALIZED_LENGTH ? wordLength : 0];
+}
+
+#ifdef ENTROPY_THREADS
+// Persistent thread pool for parallel loops. The range is cut into chunks dealt out as
+// contiguous runs, one per worker; a worker that finishes its run steals from the others.
+class WorkerPool {
+private:
+    struct alignas(64) ChunkQueue {
+        std::atomic<size_t> next{0};
+        size_t end = 0;
+    };
+
+    std::vector<std::thread> threads;
+    std::unique_ptr<ChunkQueue[]> queues;
+    size_t workerCount = 1;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const std::function<void(size_t, size_t, size_t)>* task = nullptr;
+    size_t taskCount = 0;
+    size_t taskGrain = 1;
+    uint64_t generation = 0;
+    size_t running = 0;
+    bool stopping = false;
+
+    void runChunks(size_t worker) {
+        for (size_t offset = 0; offset < workerCount; offset++) {
+            ChunkQueue& queue = queues[(worker + offset) % workerCount];
+            for (;;) {
+                size_t chunk = queue.next.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= queue.end) break;
+                size_t begin = chunk * taskGrain;
+                (*task)(begin, std::min(begin + taskGrain, taskCount), worker);
+            }
+        }
+    }
+
+    void workerLoop(size_t worker, uint64_t seen) {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            runChunks(worker);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--running == 0) finished.notify_one();
+            }
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads) thread.join();
+        threads.clear();
+        stopping = false;
+    }
+
+public:
+    WorkerPool() : queues(new ChunkQueue[1]) {}
+    ~WorkerPool() { stop(); }
+
+    size_t size() const { return workerCount; }
+
+    // Total workers including the calling thread
+    void resize(size_t count) {
+        count = std::max<size_t>(1, count);
+        if (count == workerCount) return;
+        stop();
+        workerCount = count;
+        queues.reset(new ChunkQueue[workerCount]);
+        for (size_t worker = 1; worker < workerCount; worker++) {
+            threads.emplace_back(&WorkerPool::workerLoop, this, worker, generation);
+        }
+    }
+
+    // Calls fn(begin, end, worker) over [0, count) in chunks of grain; blocks until done
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t, size_t)>& fn) {
+        if (count == 0) return;
+        grain = std::max<size_t>(1, grain);
+        size_t chunks = (count + grain - 1) / grain;
+        if (workerCount == 1 || chunks == 1) {
+            for (size_t begin = 0; begin < count; begin += grain) {
+                fn(begin, std::min(begin + grain, count), 0);
+            }
+            return;
+        }
+
+        for (size_t worker = 0; worker < workerCount; worker++) {
+            queues[worker].next.store(chunks * worker / workerCount, std::memory_order_relaxed);
+            queues[worker].end = chunks * (worker + 1) / workerCount;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &fn;
+            taskCount = count;
+            taskGrain = grain;
+            running = workerCount - 1;
+            generation++;
+        }
+        wake.notify_all();
+        runChunks(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return running == 0; });
+        task = nullptr;
+    }
+};
+#else
+// Single-threaded stand-in used when the module is built without -pthread
+class WorkerPool {
+public:
+    size_t size() const { return 1; }
+    void resize(size_t) {}
+
+    template <typename Fn>
+    void parallelFor(size_t count, size_t grain, const Fn& fn) {
+        grain = std::max<size_t>(1, grain);
+        for (size_t begin = 0; begin < count; begin += grain) {
+            fn(begin, std::min(begin + grain, count), 0);
+        }
+    }
+};
+#endif
+
+// Hot-path counters and per-phase timings behind getStats. Build with -DENTROPY_ENABLE_STATS=0
+// to compile the recording out; getStats then reports enabled = false and zeros.
+#ifndef ENTROPY_ENABLE_STATS
+#define ENTROPY_ENABLE_STATS 1
+#endif
+
+struct EngineStats {
+    bool enabled = ENTROPY_ENABLE_STATS != 0;
+    uint64_t pairsEvaluated = 0;   // guess x answer pairs scored for entropy
+    uint64_t patternsComputed = 0; // of those, pairs whose pattern was computed (not a matrix lookup)
+    uint64_t rankings = 0;         // ranking requests, cache hits included
+    uint64_t cacheHits = 0;
+    uint64_t cacheMisses = 0;
+    uint64_t tileHits = 0;         // guesses scored from a cached matrix tile
+    uint64_t tileMisses = 0;       // guesses that computed a tile or fell back to direct scoring
+    uint64_t tileBytes = 0;        // held by the tile cache
+    double marshalInMs = 0;        // taking in word lists: conversion, packing, matrix build
+    double computeMs = 0;          // scoring guesses and entropy bounds
+    double sortMs = 0;             // ordering rankings
+    double marshalOutMs = 0;       // filling result buffers and JS result arrays
+    uint64_t scratchBytes = 0;     // held by the per-call scratch arena
+    uint64_t scratchBlocks = 0;    // arena blocks; stops growing once calls reach steady state
+};
+
+#if ENTROPY_ENABLE_STATS
+// Adds the lifetime of the scope to one EngineStats phase
+class PhaseTimer {
+private:
+    double& total;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit PhaseTimer(double& phaseTotal) : total(phaseTotal), start(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() {
+        total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+#define ENTROPY_PHASE(owner, phase) PhaseTimer phaseTimer((owner).phase)
+#else
+#define ENTROPY_PHASE(owner, phase) ((void)0)
+#endif
+
+// (entropy, guess index); ties rank the earlier guess first so results are deterministic
+typedef std::pair<double, uint32_t> RankedGuess;
+
+static inline uint64_t mixHash(uint64_t x) {
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27; x *= 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static uint64_t hashBytes(const uint8_t* bytes, size_t length) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < length; i++) hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return mixHash(hash);
+}
+
+// hashBytes eight bytes at a step, for checksums over whole snapshots
+static uint64_t hashWords(const uint8_t* bytes, size_t length) {
+    uint64_t hash = 0xCBF29CE484222325ull ^ length;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001B3ull;
+        hash ^= hash >> 29;
+    }
+    for (; i < length; i++) hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    return mixHash(hash);
+}
+
+// LRU of guess rankings keyed by a hash of the guess list and remaining answers, bounded in bytes.
+// A stored ranking of k guesses serves any later request for up to k (or any, once complete).
+class RankingCache {
+private:
+    struct Entry {
+        uint64_t key;
+        size_t answerCount; // guards against hash collisions between sets of different sizes
+        bool complete;      // ranking covers every guess
+        std::vector<RankedGuess> ranking;
+    };
+
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+    size_t budget = DEFAULT_BUDGET;
+    size_t bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    static size_t entryBytes(const Entry& entry) {
+        return sizeof(Entry) + 4 * sizeof(void*) + entry.ranking.size() * sizeof(RankedGuess);
+    }
+
+    void erase(std::list<Entry>::iterator it) {
+        bytes -= entryBytes(*it);
+        index.erase(it->key);
+        entries.erase(it);
+    }
+
+    void evict() {
+        while (bytes > budget && !entries.empty()) erase(std::prev(entries.end()));
+    }
+
+public:
+    static constexpr size_t DEFAULT_BUDGET = 8 * 1024 * 1024;
+
+    bool enabled() const { return budget > 0; }
+
+    // Cached ranking holding at least `limit` guesses, or nullptr; a hit becomes most recent
+    const std::vector<RankedGuess>* find(uint64_t key, size_t answerCount, size_t limit) {
+        auto it = index.find(key);
+        if (it == index.end() || it->second->answerCount != answerCount ||
+            (!it->second->complete && it->second->ranking.size() < limit)) {
+            misses++;
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        hits++;
+        return &entries.front().ranking;
+    }
+
+    void store(uint64_t key, size_t answerCount, const std::vector<RankedGuess>& ranking, bool complete) {
+        if (!enabled()) return;
+        auto it = index.find(key);
+        if (it != index.end()) erase(it->second);
+        entries.push_front({key, answerCount, complete, ranking});
+        index[key] = entries.begin();
+        bytes += entryBytes(entries.front());
+        evict();
+    }
+
+    void clear() {
+        entries.clear();
+        index.clear();
+        bytes = 0;
+    }
+
+    void setBudget(size_t maxBytes) {
+        budget = maxBytes;
+        evict();
+    }
+
+    size_t byteSize() const { return bytes; }
+    size_t size() const { return entries.size(); }
+    uint64_t hitCount() const { return hits; }
+    uint64_t missCount() const { return misses; }
+    void resetCounters() { hits = misses = 0; }
+};
+
+// Bump allocator for per-call scratch. Blocks stay allocated between calls, so once a call
+// has run at its largest size the repeats allocate nothing; a Scope rewinds everything taken
+// since it was opened. Only the calling thread allocates: workers write into reserved buffers.
+class ScratchArena {
+private:
+    static constexpr size_t MIN_BLOCK_BYTES = 64 * 1024;
+
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t bytes;
+    };
+    std::vector<Block> blocks;
+    size_t current = 0; // block being bumped
+    size_t offset = 0;  // bytes used in it
+
+public:
+    class Scope {
+    private:
+        ScratchArena& arena;
+        size_t block;
+        size_t mark;
+
+    public:
+        explicit Scope(ScratchArena& owner) : arena(owner), block(owner.current), mark(owner.offset) {}
+        ~Scope() {
+            arena.current = block;
+            arena.offset = mark;
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // `alignment` must be a power of two
+    void* allocate(size_t bytes, size_t alignment) {
+        for (;;) {
+            if (current < blocks.size()) {
+                Block& block = blocks[current];
+                size_t start = (offset + alignment - 1) & ~(alignment - 1);
+                if (start + bytes <= block.bytes) {
+                    offset = start + bytes;
+                    return block.data.get() + start;
+                }
+                if (current + 1 < blocks.size()) {
+                    current++;
+                    offset = 0;
+                    continue;
+                }
+            }
+            // Doubling keeps the number of blocks logarithmic in the high-water mark
+            size_t size = std::max(MIN_BLOCK_BYTES, bytes + alignment);
+            if (!blocks.empty()) size = std::max(size, blocks.back().bytes * 2);
+            blocks.push_back({std::unique_ptr<uint8_t[]>(new uint8_t[size]), size});
+            current = blocks.size() - 1;
+            offset = 0;
+        }
+    }
+
+    size_t blockCount() const { return blocks.size(); }
+    size_t reservedBytes() const {
+        size_t total = 0;
+        for (const Block& block : blocks) total += block.bytes;
+        return total;
+    }
+};
+
+// std::allocator stand-in drawing from a ScratchArena; memory returns when the Scope closes
+template <typename T>
+struct ArenaAllocator {
+    typedef T value_type;
+    ScratchArena* arena;
+
+    explicit ArenaAllocator(ScratchArena& owner) : arena(&owner) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) {
+        // new[] blocks are aligned for any fundamental type, offsets are aligned within them
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template <typename T>
+using ScratchVector = std::vector<T, ArenaAllocator<T>>;
+
+class EntropyCalculator {
+private:
+    WordStore allWords;
+    WordStore possibleAnswers;
+
+    // Matrix mode: patterns for every (guess, answer column) pair are computed once in
+    // setWordLists, and possibleAnswers becomes a subset of columns answered by lookups
+    static constexpr uint64_t DEFAULT_MATRIX_BUDGET = 256ull * 1024 * 1024;
+    bool matrixMode = false;
+    uint64_t matrixBudget = DEFAULT_MATRIX_BUDGET;
+    PatternMatrix matrix;
+    WordStore matrixAnswers;
+    std::vector<uint32_t> activeColumns;
+
+    // Matrix mode past the budget: tiles over the candidates, within the same budget.
+    // tileColumns holds each candidate's tile column, parallel to scoringWeights().
+    PatternTileCache tiles;
+    std::vector<uint32_t> tileColumns;
+
+    // Guesses are scored in parallel; each worker owns one histogram
+    static constexpr size_t GUESS_GRAIN = 64;
+    WorkerPool pool;
+    std::vector<PatternHistogram> histograms = std::vector<PatternHistogram>(1);
+
+    // Scoring, matrix and filter loops for the answers' word length, chosen with the word lists
+    const LengthKernels* kernels = &kernelsFor(0);
+
+    CompiledConstraints constraints;
+
+    // Posting bitsets for setConstraints lookups over the guesses and over the answers, built
+    // on first use and dropped whenever the rows they index are replaced (rebuilt when they grow)
+    PostingIndex guessPostings;
+    PostingIndex answerPostings;
+    CandidateSet constraintMatches;
+
+    void clearPostings() {
+        guessPostings.clear();
+        answerPostings.clear();
+    }
+
+    // The compiled constraints' rows of `words` (allWords or possibleAnswers) in constraintMatches
+    const CandidateSet& constrainedRows(PostingIndex& postings, const WordStore& words) {
+        if (!postings.ready() || postings.rowCount() != words.size()) postings.build(words);
+        postings.resolve(constraints, constraintMatches);
+        return constraintMatches;
+    }
+
+    // Per-call scratch: temporaries of filtering and ranking come from the arena, and the
+    // filter inputs are packed into stores that keep their capacity between calls
+    ScratchArena scratch;
+    WordStore filterStore;
+    CompiledConstraints filterConstraints;
+    WordConstraints constraintInput;
+
+    template <typename T>
+    ScratchVector<T> scratchVector(size_t count = 0) {
+        return ScratchVector<T>(count, ArenaAllocator<T>(scratch));
+    }
+
+    // Rankings memoized by candidate content: paths converging on the same answers, undo, and
+    // re-sent word lists all hit. Keys hash words rather than row numbers, so they stay valid
+    // across setWordLists calls; the guess list hash is order-sensitive because entries hold indices.
+    RankingCache rankingCache;
+#if ENTROPY_ENABLE_STATS
+    EngineStats stats;
+#endif
+
+    // Records `guesses` scored against the current candidates
+    void countScored(size_t guesses) {
+#if ENTROPY_ENABLE_STATS
+        uint64_t pairs = static_cast<uint64_t>(guesses) * candidates.size();
+        stats.pairsEvaluated += pairs;
+        if (!isMatrixActive()) stats.patternsComputed += pairs;
+#else
+        (void)guesses;
+#endif
+    }
+    std::vector<uint64_t> answerHashes; // per possibleAnswers row
+    uint64_t guessListHash = 0;
+
+    void refreshListHashes() {
+        guessListHash = mixHash(allWords.wordLength());
+        for (size_t i = 0; i < allWords.size(); i++) {
+            guessListHash = mixHash(guessListHash ^ hashBytes(allWords.row(i), allWords.wordLength()));
+        }
+        answerHashes.resize(possibleAnswers.size());
+        for (size_t i = 0; i < possibleAnswers.size(); i++) {
+            answerHashes[i] = hashBytes(possibleAnswers.row(i), possibleAnswers.wordLength());
+            // Weighted rankings differ, so the prior is part of each answer's identity
+            if (!answerWeights.empty()) answerHashes[i] = mixHash(answerHashes[i] ^ mixHash(answerWeights[i]));
+        }
+    }
+
+    // Order-independent sum over the remaining answers, combined with the guess list and length
+    uint64_t candidateKey() const {
+        uint64_t sum = 0;
+        candidates.forEach([&](size_t index) { sum += answerHashes[index]; });
+        uint64_t key = mixHash(sum ^ mixHash(guessListHash + possibleAnswers.wordLength()));
+        return hardGuessHash != 0 ? mixHash(key ^ hardGuessHash) : key;
+    }
+
+    // Hard mode: guesses must reuse the hints compiled by setConstraints, so rankings walk only
+    // the allowed rows of allWords. Inactive while streaming, as the guess list is still growing.
+    bool hardMode = false;
+    std::vector<uint32_t> hardGuesses;
+    uint64_t hardGuessHash = 0; // 0 when every guess is allowed
+
+    bool hardModeActive() const {
+        return hardMode && !streaming;
+    }
+
+    size_t guessCount() const {
+        return hardModeActive() ? hardGuesses.size() : allWords.size();
+    }
+
+    uint32_t guessRow(size_t i) const {
+        return hardModeActive() ? hardGuesses[i] : static_cast<uint32_t>(i);
+    }
+
+    // Rebuilds the allowed guess rows after the hints, the guesses or the flag change; a running
+    // ranking job is left stale
+    void refreshHardGuesses() {
+        hardGuesses.clear();
+        hardGuessHash = 0;
+        if (hardModeActive()) {
+            // Constraints compiled for another length carry no hints for these guesses
+            bool hinted = constraints.wordLength() == allWords.wordLength();
+            hardGuessHash = mixHash(allWords.size() + 1);
+            for (size_t i = 0; i < allWords.size(); i++) {
+                if (!hinted || constraints.satisfiesHints(allWords.row(i), allWords.presence(i))) {
+                    hardGuesses.push_back(static_cast<uint32_t>(i));
+                    hardGuessHash = mixHash(hardGuessHash ^ i);
+                }
+            }
+        }
+        candidateGeneration++;
+    }
+
+    // Candidate answers narrowed by applyFeedback, as rows of possibleAnswers, with the
+    // previous sets kept for undo. While narrowed, scoring reads a compacted copy of the
+    // remaining rows (direct mode) or their matrix columns (matrix mode).
+    CandidateSet candidates;
+    std::vector<CandidateSet> feedbackHistory;
+    WordStore candidateAnswers;
+    std::vector<uint32_t> candidateColumns;
+
+    const WordStore& scoringAnswers() const {
+        return candidates.full() ? possibleAnswers : candidateAnswers;
+    }
+
+    const std::vector<uint32_t>& scoringColumns() const {
+        return candidates.full() ? activeColumns : candidateColumns;
+    }
+
+    // Answer priors (setAnswerPriors) quantized to integers so the histograms stay integer:
+    // per possibleAnswers row, and compacted alongside candidateAnswers. Empty means uniform.
+    static constexpr uint32_t PRIOR_SCALE = 65535;
+    std::vector<uint32_t> answerWeights;
+    std::vector<uint32_t> candidateWeights;
+
+    // Weights parallel to scoringAnswers()/scoringColumns(), or null when answers are uniform
+    const uint32_t* scoringWeights() const {
+        if (answerWeights.empty()) return nullptr;
+        return candidates.full() ? answerWeights.data() : candidateWeights.data();
+    }
+
+    // Bumped whenever the candidate state changes, so a pending ranking job can tell it is stale
+    uint64_t candidateGeneration = 0;
+
+    // `narrowed`: feedback shrank the candidates, so the tiles may rebase onto the smaller set
+    void refreshCandidateViews(bool narrowed = false) {
+        candidateGeneration++;
+        candidateAnswers.reset(possibleAnswers.wordLength());
+        candidateColumns.clear();
+        candidateWeights.clear();
+        refreshTiles(narrowed);
+        if (candidates.full()) {
+            return;
+        }
+        bool matrixColumns = isMatrixActive();
+        bool weighted = !answerWeights.empty();
+        candidates.forEach([&](size_t index) {
+            candidateAnswers.appendRow(possibleAnswers.row(index), possibleAnswers.presence(index));
+            if (matrixColumns) candidateColumns.push_back(activeColumns[index]);
+            if (weighted) candidateWeights.push_back(answerWeights[index]);
+        });
+        if (simdEnabled) {
+            candidateAnswers.buildColumns();
+        }
+    }
+
+    bool tilingPossible() const {
+        size_t length = possibleAnswers.wordLength();
+        return matrixMode && !streaming && !isMatrixActive() && candidates.size() > 1 && length > 0 &&
+               length <= PatternMatrix::MAX_WORD_LENGTH && allWords.wordLength() == length;
+    }
+
+    // Keeps tile columns covering the candidates: the tiles rebase when a candidate falls outside
+    // them, or when feedback leaves under a quarter of the columns. Subsets (lookahead partitions,
+    // narrower feedback) keep reusing the tiles computed for the wider set.
+    void refreshTiles(bool narrowed) {
+        tileColumns.clear();
+        if (!tilingPossible()) {
+            if (tiles.active()) tiles.reset();
+            return;
+        }
+        bool rebase = !tiles.covers(candidates) || (narrowed && candidates.size() * 4 <= tiles.columnCount());
+        if (rebase && !tiles.rebase(possibleAnswers, candidates, allWords.size(), simdEnabled)) {
+            return;
+        }
+        candidates.forEach([&](size_t index) { tileColumns.push_back(tiles.columnOf(index)); });
+    }
+
+    // Below this many candidates the tile lookups and the cache lock cost about what computing
+    // the patterns does, so small sets (most lookahead partitions) are scored directly
+    static constexpr size_t MIN_TILED_CANDIDATES = 128;
+
+    bool isTiled() const {
+        return tiles.active() && tileColumns.size() >= MIN_TILED_CANDIDATES;
+    }
+
+    // Guess `row`'s tile with the row computed, or nullptr when the cache has it scored directly
+    const PatternMatrix* tileFor(size_t row) {
+        bool fill = false;
+        const PatternMatrix* tile = tiles.claim(row, fill);
+        if (fill) {
+            const WordStore& answers = tiles.answers();
+            kernels->fillMatrixRow(allWords.row(row), answers, useSimd(answers), tiles.fillTarget(row),
+                                   row % PatternTileCache::TILE_ROWS);
+            tiles.publish(row);
+        }
+        return tile;
+    }
+
+    template <typename Cell>
+    double tileRowEntropy(const Cell* codes, PatternHistogram& histogram) {
+        size_t total = tileColumns.size();
+        histogram.reset(allWords.wordLength(), total);
+        if (const uint32_t* weights = scoringWeights()) {
+            for (size_t i = 0; i < total; i++) histogram.add(codes[tileColumns[i]], weights[i]);
+        } else {
+            for (uint32_t col : tileColumns) histogram.add(codes[col]);
+        }
+        return histogram.entropy();
+    }
+
+    double tileRowEntropy(const PatternMatrix& tile, size_t row, PatternHistogram& histogram) {
+        size_t tileRow = row % PatternTileCache::TILE_ROWS;
+        switch (tile.cellSize()) {
+            case 1: return tileRowEntropy(tile.rowCells<uint8_t>(tileRow), histogram);
+            case 2: return tileRowEntropy(tile.rowCells<uint16_t>(tileRow), histogram);
+            default: return tileRowEntropy(tile.rowCells<uint32_t>(tileRow), histogram);
+        }
+    }
+
+    void resetCandidateState() {
+        candidates.fill(possibleAnswers.size());
+        feedbackHistory.clear();
+        refreshCandidateViews();
+    }
+
+    // Multi-board play (Quordle, Octordle): one candidate set per board over possibleAnswers,
+    // each narrowed by its own feedback. A ranking computes a guess's codes once over the union
+    // of the open boards, then histograms each board from those codes.
+    std::vector<CandidateSet> boards;
+    std::vector<std::vector<CandidateSet>> boardHistory;
+    WordStore boardAnswers;                 // union of the open boards' candidates
+    std::vector<uint32_t> boardColumns;     // their matrix columns in matrix mode
+    std::vector<uint32_t> boardMembers;     // per open board, its rows of boardAnswers
+    std::vector<uint32_t> boardMemberWeights;
+    std::vector<size_t> boardOffsets;       // open board b owns members [offsets[b], offsets[b + 1])
+
+    // Packs the open boards (two or more candidates; the others score 0) before each board
+    // ranking, so matrix and prior changes need no extra bookkeeping
+    void refreshBoardViews() {
+        boardAnswers.reset(possibleAnswers.wordLength());
+        boardColumns.clear();
+        boardMembers.clear();
+        boardMemberWeights.clear();
+        boardOffsets.assign(1, 0);
+
+        ScratchArena::Scope scope(scratch);
+        ScratchVector<uint32_t> position = scratchVector<uint32_t>(possibleAnswers.size());
+        std::fill(position.begin(), position.end(), UINT32_MAX);
+        bool matrixColumns = isMatrixActive();
+        bool weighted = !answerWeights.empty();
+        for (const CandidateSet& board : boards) {
+            if (board.size() <= 1) continue;
+            board.forEach([&](size_t index) {
+                if (position[index] == UINT32_MAX) {
+                    position[index] = static_cast<uint32_t>(boardAnswers.size());
+                    boardAnswers.appendRow(possibleAnswers.row(index), possibleAnswers.presence(index));
+                    if (matrixColumns) boardColumns.push_back(activeColumns[index]);
+                }
+                boardMembers.push_back(position[index]);
+                if (weighted) boardMemberWeights.push_back(answerWeights[index]);
+            });
+            boardOffsets.push_back(boardMembers.size());
+        }
+        if (simdEnabled) {
+            boardAnswers.buildColumns();
+        }
+    }
+
+    // Summed entropy of one guess over the open boards. The boards' answers are independent,
+    // so this is also the joint entropy of the feedback tuple. `codes` has room for the union.
+    double boardEntropy(size_t guessIndex, PatternCode* codes, PatternHistogram& histogram) {
+        size_t length = possibleAnswers.wordLength();
+        if (isMatrixActive()) {
+            for (size_t i = 0; i < boardColumns.size(); i++) codes[i] = matrix.at(guessIndex, boardColumns[i]);
+        } else if (allWords.wordLength() == length) {
+            kernels->patternRow(allWords.row(guessIndex), boardAnswers, useSimd(boardAnswers), codes);
+        } else {
+            return 0.0;
+        }
+
+        double total = 0.0;
+        const uint32_t* weights = boardMemberWeights.empty() ? nullptr : boardMemberWeights.data();
+        for (size_t b = 0; b + 1 < boardOffsets.size(); b++) {
+            size_t begin = boardOffsets[b];
+            size_t end = boardOffsets[b + 1];
+            histogram.reset(length, end - begin);
+            for (size_t m = begin; m < end; m++) histogram.add(codes[boardMembers[m]], weights ? weights[m] : 1);
+            total += histogram.entropy();
+        }
+        return total;
+    }
+
+#ifdef ENTROPY_SIMD
+    bool simdEnabled = true;
+#else
+    bool simdEnabled = false;
+#endif
+
+    bool useSimd(const WordStore& answers) const {
+#ifdef ENTROPY_SIMD
+        return simdEnabled && answers.wordLength() <= SIMD_MAX_LENGTH && answers.hasColumns();
+#else
+        (void)answers;
+        return false;
+#endif
+    }
+
+    void clearMatrix() {
+        matrix.clear();
+        matrixAnswers.clear();
+        activeColumns.clear();
+        tiles.reset();
+        tileColumns.clear();
+    }
+
+    // Maps possibleAnswers onto matrix columns; false if any answer is outside the matrix
+    bool selectActiveColumns() {
+        activeColumns.clear();
+        if (matrix.empty()) return false;
+        if (possibleAnswers.empty()) return true;
+        if (possibleAnswers.wordLength() != matrixAnswers.wordLength()) return false;
+        activeColumns.reserve(possibleAnswers.size());
+        for (size_t i = 0; i < possibleAnswers.size(); i++) {
+            int col = matrixAnswers.find(possibleAnswers.word(i));
+            if (col < 0) {
+                activeColumns.clear();
+                return false;
+            }
+            activeColumns.push_back(static_cast<uint32_t>(col));
+        }
+        return true;
+    }
+
+    // Fills the guess x answer table; requires both lists to share a length within the matrix limits
+    bool buildMatrix() {
+        clearMatrix();
+
+        size_t length = allWords.wordLength();
+        if (length == 0 || length > PatternMatrix::MAX_WORD_LENGTH) return false;
+        if (possibleAnswers.wordLength() != length) return false;
+        if (PatternMatrix::bytesRequired(allWords.size(), possibleAnswers.size(), length) > matrixBudget) {
+            return false;
+        }
+
+        matrixAnswers = possibleAnswers;
+        matrix.resize(allWords.size(), matrixAnswers.size(), length);
+#if ENTROPY_ENABLE_STATS
+        stats.patternsComputed += static_cast<uint64_t>(allWords.size()) * matrixAnswers.size();
+#endif
+        bool simd = useSimd(matrixAnswers);
+        pool.parallelFor(allWords.size(), GUESS_GRAIN, [&](size_t begin, size_t end, size_t) {
+            for (size_t g = begin; g < end; g++) {
+                kernels->fillMatrixRow(allWords.row(g), matrixAnswers, simd, matrix, g);
+            }
+        });
+
+        return selectActiveColumns();
+    }
+
+    // Shannon entropy of one matrix row restricted to the active answer columns
+    double matrixRowEntropy(size_t row, PatternHistogram& histogram) {
+        const std::vector<uint32_t>& columns = scoringColumns();
+        size_t total = columns.size();
+        if (total <= 1) {
+            return 0.0;
+        }
+
+        histogram.reset(allWords.wordLength(), total);
+        if (const uint32_t* weights = scoringWeights()) {
+            for (size_t i = 0; i < total; i++) histogram.add(matrix.at(row, columns[i]), weights[i]);
+        } else {
+            for (uint32_t col : columns) histogram.add(matrix.at(row, col));
+        }
+        return histogram.entropy();
+    }
+
+    // Entropy of a packed guess row against every candidate answer
+    double rowEntropy(const uint8_t* guess, PatternHistogram& histogram) {
+        const WordStore& answers = scoringAnswers();
+        histogram.reset(answers.wordLength(), answers.size());
+        kernels->scoreRow(guess, answers, scoringWeights(), useSimd(answers), histogram);
+        return histogram.entropy();
+    }
+
+    double guessEntropy(size_t guessIndex, PatternHistogram& histogram) {
+        if (candidates.size() <= 1) {
+            return 0.0;
+        }
+        if (isMatrixActive()) {
+            return matrixRowEntropy(guessIndex, histogram);
+        }
+        if (isTiled()) {
+            if (const PatternMatrix* tile = tileFor(guessIndex)) return tileRowEntropy(*tile, guessIndex, histogram);
+        }
+        if (allWords.wordLength() != possibleAnswers.wordLength()) {
+            return 0.0;
+        }
+        return rowEntropy(allWords.row(guessIndex), histogram);
+    }
+
+    // Installs freshly packed lists, reusing the matrix when the guesses are unchanged
+    void installWordLists(WordStore&& guesses, WordStore&& answers) {
+        streaming = false;
+        bool sameGuesses = guesses.sameWords(allWords);
+        allWords = std::move(guesses);
+        possibleAnswers = std::move(answers);
+        clearPostings();
+        answerWeights.clear();
+        boards.clear();
+        boardHistory.clear();
+        kernels = &kernelsFor(possibleAnswers.wordLength());
+        if (simdEnabled) {
+            possibleAnswers.buildColumns();
+        }
+
+        if (matrixMode) {
+            // Same guesses and answers inside the existing columns: only the subset changes
+            if (!(sameGuesses && selectActiveColumns())) {
+                buildMatrix();
+            }
+        }
+        refreshListHashes();
+        refreshHardGuesses();
+        resetCandidateState();
+    }
+
+    static bool rankedBefore(const RankedGuess& a, const RankedGuess& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }
+
+    // Keeps `entry` if it beats the worst of the best `limit` so far (heap with the worst on top)
+    template <typename Heap>
+    static void offerRanked(Heap& heap, size_t limit, const RankedGuess& entry) {
+        if (heap.size() < limit) {
+            heap.push_back(entry);
+            std::push_heap(heap.begin(), heap.end(), rankedBefore);
+        } else if (rankedBefore(entry, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), rankedBefore);
+            heap.back() = entry;
+            std::push_heap(heap.begin(), heap.end(), rankedBefore);
+        }
+    }
+
+    // Branch and bound for top-k: a pattern's entropy is at most the sum of its tiles'
+    // entropies, and each tile's G/Y/B split is bounded by letter counts over the answers
+    static constexpr double BOUND_SLACK = 1e-9; // absorbs rounding between bound and exact score
+    bool pruningEnabled = true;
+    size_t lastScoredGuesses = 0;
+
+    static double tileEntropy(double green, double yellow) {
+        double term = 0.0;
+        for (double p : {green, yellow, 1.0 - green - yellow}) {
+            if (p > 0.0) term -= p * std::log2(p);
+        }
+        return term;
+    }
+
+    bool canPrune(size_t limit) const {
+        return pruningEnabled && limit > 0 && limit < guessCount() && candidates.size() > 1 &&
+               allWords.wordLength() == scoringAnswers().wordLength();
+    }
+
+    // Upper bound on every guess's entropy into `bounds`; O(answers x length) counting plus
+    // O(length) per guess
+    template <typename Bounds>
+    void entropyBounds(Bounds& bounds) {
+        ENTROPY_PHASE(stats, computeMs);
+        bounds.resize(allWords.size()); // before the scope, which would reclaim it
+        ScratchArena::Scope scope(scratch);
+        // Tile splits are taken over prior mass when weighted; the bound holds for any distribution
+        const WordStore& answers = scoringAnswers();
+        const uint32_t* weights = scoringWeights();
+        size_t length = answers.wordLength();
+        size_t total = answers.size();
+        ScratchVector<uint32_t> positional = scratchVector<uint32_t>(length * ALPHABET_SLOTS);
+        uint32_t containing[ALPHABET_SLOTS] = {0};
+        uint64_t mass = 0;
+        for (size_t a = 0; a < total; a++) {
+            const uint8_t* answer = answers.row(a);
+            uint32_t weight = weights ? weights[a] : 1;
+            mass += weight;
+            for (size_t p = 0; p < length; p++) positional[p * ALPHABET_SLOTS + answer[p]] += weight;
+            for (uint32_t bits = answers.presence(a); bits != 0; bits &= bits - 1) {
+                containing[__builtin_ctz(bits)] += weight;
+            }
+        }
+
+        double scale = 1.0 / static_cast<double>(mass);
+        double cap = std::log2(static_cast<double>(total));
+        pool.parallelFor(allWords.size(), GUESS_GRAIN, [&](size_t begin, size_t end, size_t) {
+            for (size_t g = begin; g < end; g++) {
+                const uint8_t* guess = allWords.row(g);
+                uint32_t seen = 0;
+                uint32_t repeated = 0;
+                for (size_t p = 0; p < length; p++) {
+                    uint32_t bit = 1u << guess[p];
+                    repeated |= seen & bit;
+                    seen |= bit;
+                }
+
+                double bound = 0.0;
+                for (size_t p = 0; p < length; p++) {
+                    uint8_t letter = guess[p];
+                    double green = positional[p * ALPHABET_SLOTS + letter] * scale;
+                    // A single copy is yellow exactly when the answer has it elsewhere; repeated
+                    // copies can only be yellow less often, so take the split that maximizes entropy
+                    double yellow = containing[letter] * scale - green;
+                    if (repeated & (1u << letter)) yellow = std::min(yellow, (1.0 - green) / 2.0);
+                    bound += tileEntropy(green, std::max(yellow, 0.0));
+                }
+                bounds[g] = std::min(bound, cap);
+            }
+        });
+    }
+
+    // Scores guesses in descending bound order and stops once no remaining bound can reach the
+    // k-th best exact entropy; returns the same ranking as the exhaustive path
+    std::vector<RankedGuess> rankTopGuessesPruned(size_t limit) {
+        ScratchArena::Scope scope(scratch);
+        ScratchVector<double> bounds = scratchVector<double>();
+        entropyBounds(bounds);
+        tiles.beginPass();
+        size_t guessCount = this->guessCount();
+        ScratchVector<uint32_t> order = scratchVector<uint32_t>(guessCount);
+        for (size_t i = 0; i < guessCount; i++) order[i] = guessRow(i);
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return bounds[a] > bounds[b] || (bounds[a] == bounds[b] && a < b);
+        });
+
+        ScratchVector<RankedGuess> heap = scratchVector<RankedGuess>();
+        heap.reserve(limit);
+        size_t batch = std::max(limit, GUESS_GRAIN * pool.size() * 4);
+        ScratchVector<double> scores = scratchVector<double>(batch);
+        size_t next = 0;
+        while (next < guessCount) {
+            size_t end = std::min(guessCount, next + batch);
+            if (heap.size() == limit) {
+                // Bounds are sorted, so the first one below the threshold ends the search
+                double threshold = heap.front().first - BOUND_SLACK;
+                end = static_cast<size_t>(std::partition_point(order.begin() + next, order.begin() + end,
+                    [&](uint32_t g) { return bounds[g] >= threshold; }) - order.begin());
+                if (end == next) break;
+            }
+
+            {
+                ENTROPY_PHASE(stats, computeMs);
+                pool.parallelFor(end - next, GUESS_GRAIN, [&](size_t begin, size_t stop, size_t worker) {
+                    for (size_t i = begin; i < stop; i++) {
+                        scores[i] = guessEntropy(order[next + i], histograms[worker]);
+                    }
+                });
+            }
+            for (size_t i = next; i < end; i++) {
+                offerRanked(heap, limit, {scores[i - next], order[i]});
+            }
+            next = end;
+        }
+
+        lastScoredGuesses = next;
+        countScored(next);
+        ENTROPY_PHASE(stats, sortMs);
+        std::sort(heap.begin(), heap.end(), rankedBefore);
+        return std::vector<RankedGuess>(heap.begin(), heap.end());
+    }
+
+    // Scores every guess with score(row, worker) and keeps the best `limit`, highest first. Below
+    // the full list each worker keeps a bounded heap (worst kept guess on top), so nothing is fully sorted.
+    template <typename Score>
+    std::vector<RankedGuess> rankByScore(size_t limit, const Score& score) {
+        tiles.beginPass();
+        size_t guessCount = this->guessCount();
+        lastScoredGuesses = guessCount;
+        if (limit >= guessCount) {
+            std::vector<RankedGuess> entropyPairs(guessCount);
+            {
+                ENTROPY_PHASE(stats, computeMs);
+                pool.parallelFor(guessCount, GUESS_GRAIN, [&](size_t begin, size_t end, size_t worker) {
+                    for (size_t i = begin; i < end; i++) {
+                        uint32_t row = guessRow(i);
+                        entropyPairs[i] = {score(row, worker), row};
+                    }
+                });
+            }
+            ENTROPY_PHASE(stats, sortMs);
+            std::sort(entropyPairs.begin(), entropyPairs.end(), rankedBefore);
+            return entropyPairs;
+        }
+
+        if (limit == 0) {
+            return {};
+        }
+        // Reserved here because workers must not allocate from the arena
+        ScratchArena::Scope scope(scratch);
+        ScratchVector<ScratchVector<RankedGuess>> heaps(pool.size(), scratchVector<RankedGuess>(),
+                                                         ArenaAllocator<ScratchVector<RankedGuess>>(scratch));
+        for (auto& heap : heaps) heap.reserve(limit);
+        {
+            ENTROPY_PHASE(stats, computeMs);
+            pool.parallelFor(guessCount, GUESS_GRAIN, [&](size_t begin, size_t end, size_t worker) {
+                ScratchVector<RankedGuess>& heap = heaps[worker];
+                for (size_t i = begin; i < end; i++) {
+                    uint32_t row = guessRow(i);
+                    offerRanked(heap, limit, {score(row, worker), row});
+                }
+            });
+        }
+
+        // At most workers x limit survivors left to order
+        ENTROPY_PHASE(stats, sortMs);
+        std::vector<RankedGuess> top;
+        for (const auto& heap : heaps) top.insert(top.end(), heap.begin(), heap.end());
+        size_t kept = std::min(limit, top.size());
+        std::partial_sort(top.begin(), top.begin() + kept, top.end(), rankedBefore);
+        top.resize(kept);
+        return top;
+    }
+
+    std::vector<RankedGuess> rankTopGuesses(size_t limit) {
+        if (canPrune(limit)) {
+            return rankTopGuessesPruned(limit);
+        }
+        if (limit > 0) countScored(guessCount());
+        return rankByScore(limit, [&](uint32_t row, size_t worker) { return guessEntropy(row, histograms[worker]); });
+    }
+
+    // Best `limit` guesses by summed entropy over the boards; each worker gets a slice of
+    // `codes` for the union of the open boards
+    std::vector<RankedGuess> rankBoardGuesses(size_t limit) {
+        if (boardOffsets.size() <= 1) {
+            return {};
+        }
+        ScratchArena::Scope scope(scratch);
+        size_t stride = boardAnswers.size();
+        ScratchVector<PatternCode> codes = scratchVector<PatternCode>(stride * pool.size());
+#if ENTROPY_ENABLE_STATS
+        stats.rankings++;
+        if (limit > 0) {
+            uint64_t pairs = static_cast<uint64_t>(guessCount()) * boardMembers.size();
+            stats.pairsEvaluated += pairs;
+            if (!isMatrixActive()) stats.patternsComputed += static_cast<uint64_t>(guessCount()) * stride;
+        }
+#endif
+        return rankByScore(limit, [&](uint32_t row, size_t worker) {
+            return boardEntropy(row, codes.data() + worker * stride, histograms[worker]);
+        });
+    }
+
+    // rankTopGuesses through the ranking cache; streams bypass it while the lists are growing
+    std::vector<RankedGuess> rankCached(size_t limit) {
+#if ENTROPY_ENABLE_STATS
+        stats.rankings++;
+#endif
+        if (streaming || !rankingCache.enabled()) {
+            return rankTopGuesses(limit);
+        }
+        uint64_t key = candidateKey();
+        if (const std::vector<RankedGuess>* cached = rankingCache.find(key, candidates.size(), limit)) {
+            lastScoredGuesses = 0;
+            return std::vector<RankedGuess>(cached->begin(), cached->begin() + std::min(limit, cached->size()));
+        }
+        std::vector<RankedGuess> ranking = rankTopGuesses(limit);
+        rankingCache.store(key, candidates.size(), ranking, limit >= guessCount());
+        return ranking;
+    }
+
+    std::vector<RankedGuess> rankAllGuesses() {
+        return rankCached(guessCount());
+    }
+
+    // Copies ranked pairs into the binary result buffers
+    int storeResults(const std::vector<RankedGuess>& ranked) {
+        ENTROPY_PHASE(stats, marshalOutMs);
+        resultIndices.clear();
+        resultEntropies.clear();
+        for (const auto& pair : ranked) {
+            resultIndices.push_back(pair.second);
+            resultEntropies.push_back(static_cast<float>(pair.first));
+        }
+        return static_cast<int>(resultIndices.size());
+    }
+
+    // Time-sliced ranking job: the same ranking as rankCached, scored a chunk at a time so the
+    // caller can report progress and abandon work between slices. Pruned jobs walk guesses in
+    // descending bound order and finish early once no bound can reach the k-th best score.
+    struct RankingJob {
+        bool active = false;
+        bool done = false;
+        bool pruned = false;
+        size_t limit = 0;
+        size_t total = 0;  // guesses the job walks
+        size_t next = 0;
+        uint64_t generation = 0;
+        uint64_t cacheKey = 0;
+        std::vector<uint32_t> order;
+        std::vector<double> bounds;
+        std::vector<RankedGuess> ranked; // heap (worst on top) below the full list
+        std::vector<double> scores;
+    };
+
+    RankingJob job;
+    std::atomic<int> jobCancel{0};
+
+    bool jobCurrent() const {
+        return job.active && job.generation == candidateGeneration;
+    }
+
+    // Scores one chunk of the job; marks it done when every needed guess has been scored
+    void stepRankingChunk() {
+        size_t guessCount = job.order.size();
+        size_t end = std::min(guessCount, job.next + GUESS_GRAIN * pool.size());
+        bool topK = job.limit < guessCount;
+        if (job.pruned && job.ranked.size() == job.limit) {
+            double threshold = job.ranked.front().first - BOUND_SLACK;
+            end = static_cast<size_t>(std::partition_point(job.order.begin() + job.next, job.order.begin() + end,
+                [&](uint32_t g) { return job.bounds[g] >= threshold; }) - job.order.begin());
+        }
+
+        size_t first = job.next;
+        job.scores.resize(end - first);
+        tiles.beginPass();
+        {
+            ENTROPY_PHASE(stats, computeMs);
+            pool.parallelFor(end - first, GUESS_GRAIN, [&](size_t begin, size_t stop, size_t worker) {
+                for (size_t i = begin; i < stop; i++) {
+                    job.scores[i] = guessEntropy(job.order[first + i], histograms[worker]);
+                }
+            });
+        }
+        countScored(end - first);
+        for (size_t i = first; i < end; i++) {
+            RankedGuess entry{job.scores[i - first], job.order[i]};
+            if (topK) {
+                offerRanked(job.ranked, job.limit, entry);
+            } else {
+                job.ranked.push_back(entry);
+            }
+        }
+
+        // A pruned job stops at the first guess whose bound fell below the threshold
+        bool cutOff = job.pruned && end < std::min(guessCount, first + GUESS_GRAIN * pool.size());
+        job.next = end;
+        job.done = end == guessCount || cutOff;
+    }
+
+    // Streaming ingestion: chunks land in allWords as they arrive, and possibleAnswers grows
+    // with the loaded rows that pass the current constraints (all rows when none are set)
+    bool streaming = false;
+    size_t streamFiltered = 0; // allWords rows already checked against the constraints
+
+    void extendStreamAnswers() {
+        bool constrained = constraints.wordLength() == allWords.wordLength();
+        for (; streamFiltered < allWords.size(); streamFiltered++) {
+            const uint8_t* letterRow = allWords.row(streamFiltered);
+            uint32_t presence = allWords.presence(streamFiltered);
+            if (!constrained || constraints.matches(letterRow, presence)) {
+                possibleAnswers.appendRow(letterRow, presence);
+            }
+        }
+        if (simdEnabled) {
+            possibleAnswers.buildColumns();
+        }
+        resetCandidateState();
+    }
+
+    // Binary results exposed to JS as views of WASM memory
+    std::vector<uint32_t> resultIndices;
+    std::vector<float> resultEntropies;
+    std::vector<uint8_t> openingTable;
+    std::vector<uint8_t> stateBuffer;
+
+    void appendWordBytes(const std::string& word) {
+        openingTable.insert(openingTable.end(), word.begin(), word.end());
+    }
+
+    // Lookahead solver: the top `solverBreadth` entropy guesses are scored by expected guesses
+    // to finish, looking `solverDepth` guesses ahead. Deeper sets fall back to an optimistic
+    // estimate, and a time budget or the cancel flag cuts the search short.
+    static constexpr int DEFAULT_SOLVER_DEPTH = 2;
+    static constexpr int DEFAULT_SOLVER_BREADTH = 10;
+    static constexpr double DEFAULT_SOLVER_BUDGET_MS = 2000.0;
+    int solverDepth = DEFAULT_SOLVER_DEPTH;
+    int solverBreadth = DEFAULT_SOLVER_BREADTH;
+    double solverBudgetMs = DEFAULT_SOLVER_BUDGET_MS;
+    std::chrono::steady_clock::time_point solverDeadline;
+    std::atomic<int> solverCancel{0}; // JS on another thread may set it with Atomics.store
+    bool solverComplete = true;
+    std::vector<float> resultScores; // expected guesses, parallel to resultIndices
+
+    bool solverStopped() {
+        if (solverCancel.load(std::memory_order_relaxed) != 0 ||
+            std::chrono::steady_clock::now() >= solverDeadline) {
+            solverComplete = false;
+        }
+        return !solverComplete;
+    }
+
+    // Optimistic estimate past the lookahead: the next guess wins or splits the rest into singletons
+    static double estimatedGuesses(size_t answerCount) {
+        return answerCount == 0 ? 0.0 : 2.0 - 1.0 / static_cast<double>(answerCount);
+    }
+
+    PatternCode patternAgainst(size_t guessIndex, uint32_t answerRow) const {
+        if (isMatrixActive()) {
+            return matrix.at(guessIndex, activeColumns[answerRow]);
+        }
+        return computePatternCode(allWords.row(guessIndex), possibleAnswers.row(answerRow), allWords.wordLength());
+    }
+
+    // Expected guesses including this one when `guessIndex` is played against `answers`
+    // (rows of possibleAnswers), with `depth` more lookahead plies for each feedback group
+    double expectedAfterGuess(size_t guessIndex, const std::vector<uint32_t>& answers, int depth) {
+        PatternCode solved = patternSpace(allWords.wordLength()) - 1;
+        std::vector<std::pair<PatternCode, uint32_t>> feedback(answers.size());
+        for (size_t i = 0; i < answers.size(); i++) {
+            feedback[i] = {patternAgainst(guessIndex, answers[i]), answers[i]};
+        }
+        std::sort(feedback.begin(), feedback.end());
+
+        double total = 1.0;
+        double scale = 1.0 / static_cast<double>(answers.size());
+        std::vector<uint32_t> group;
+        for (size_t begin = 0; begin < feedback.size();) {
+            size_t end = begin;
+            group.clear();
+            while (end < feedback.size() && feedback[end].first == feedback[begin].first) {
+                group.push_back(feedback[end++].second);
+            }
+            if (feedback[begin].first != solved) {
+                double rest = depth > 0 ? expectedToSolve(group, depth) : estimatedGuesses(group.size());
+                total += rest * group.size() * scale;
+            }
+            begin = end;
+        }
+        return total;
+    }
+
+    // Best expected guesses to solve `answers` over the lookahead candidates for that set
+    double expectedToSolve(const std::vector<uint32_t>& answers, int depth) {
+        if (answers.size() <= 2) {
+            return answers.size() == 2 ? 1.5 : static_cast<double>(answers.size());
+        }
+        if (solverStopped()) {
+            return estimatedGuesses(answers.size());
+        }
+
+        double best = HUGE_VAL;
+        for (size_t guess : lookaheadGuesses(answers)) {
+            best = std::min(best, expectedAfterGuess(guess, answers, depth - 1));
+        }
+        return best;
+    }
+
+    // Candidates and their generation, so a query that scores a subset can put both back
+    struct CandidateSnapshot {
+        CandidateSet set;
+        uint64_t generation;
+    };
+
+    CandidateSnapshot snapshotCandidates() const {
+        return {candidates, candidateGeneration};
+    }
+
+    // Rebuilds the views for the saved set and keeps its generation: the state a pending
+    // ranking job saw is back, so the job stays valid
+    void restoreCandidates(CandidateSnapshot& snapshot) {
+        candidates = std::move(snapshot.set);
+        refreshCandidateViews();
+        candidateGeneration = snapshot.generation;
+    }
+
+    // Top entropy guesses for a set, plus its own words when the set is small enough to try each.
+    // The candidates are left as they were.
+    std::vector<size_t> lookaheadGuesses(const std::vector<uint32_t>& answers) {
+        CandidateSnapshot saved = snapshotCandidates();
+        candidates.select(possibleAnswers.size(), answers);
+        refreshCandidateViews();
+        std::vector<size_t> guesses;
+        for (const RankedGuess& ranked : rankCached(static_cast<size_t>(solverBreadth))) {
+            guesses.push_back(ranked.second);
+        }
+        restoreCandidates(saved);
+        if (answers.size() <= static_cast<size_t>(solverBreadth)) {
+            for (uint32_t row : answers) {
+                int guess = allWords.find(possibleAnswers.word(row));
+                if (guess >= 0 && std::find(guesses.begin(), guesses.end(), static_cast<size_t>(guess)) == guesses.end()) {
+                    guesses.push_back(static_cast<size_t>(guess));
+                }
+            }
+        }
+        return guesses;
+    }
+
+    // Appends the row indices of the words accepted by the compiled constraints to `matches`
+    template <typename Matches>
+    void matchingWords(WordStore& words, const CompiledConstraints& compiled, Matches& matches) {
+        size_t length = words.wordLength();
+        if (compiled.wordLength() != length) {
+            return;
+        }
+        bool simd = false;
+#ifdef ENTROPY_SIMD
+        if (simdEnabled) {
+            words.buildColumns();
+            simd = true;
+        }
+#endif
+        // Filter lists may have any length, so their kernels are looked up per call
+        size_t first = matches.size();
+        matches.resize(first + words.size());
+        matches.resize(first + kernelsFor(length).filterRows(words, compiled, simd, matches.data() + first));
+    }
+
+public:
+    EntropyCalculator() {
+        tiles.setBudget(matrixBudget);
+    }
+
+    // Worker count for bulk scoring; 0 picks the hardware concurrency. Builds without
+    // -pthread always report 1 and run the single-threaded path.
+    void setThreadCount(int count) {
+#ifdef ENTROPY_THREADS
+        if (count <= 0) count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+#endif
+        pool.resize(static_cast<size_t>(std::max(1, count)));
+        histograms.resize(pool.size());
+    }
+
+    int getThreadCount() const {
+        return static_cast<int>(pool.size());
+    }
+
+    // SIMD kernels are on by default in -msimd128 builds; disabling selects the scalar path
+    void setSimdEnabled(bool enabled) {
+        simdEnabled = enabled && isSimdAvailable();
+        if (simdEnabled) {
+            possibleAnswers.buildColumns();
+            if (!candidateAnswers.empty()) candidateAnswers.buildColumns();
+        }
+    }
+
+    bool isSimdAvailable() const {
+#ifdef ENTROPY_SIMD
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool isSimdEnabled() const {
+        return simdEnabled;
+    }
+
+    // Enables the precomputed pattern matrix; takes effect on the next setWordLists
+    void setMatrixMode(bool enabled) {
+        matrixMode = enabled;
+        if (!enabled) {
+            clearMatrix();
+        }
+    }
+
+    bool isMatrixActive() const {
+        return matrixMode && !matrix.empty() && matrix.rowCount() == allWords.size() &&
+               activeColumns.size() == possibleAnswers.size();
+    }
+
+    // Upper bound on matrix memory; larger dictionaries fall back to matrix tiles over the
+    // candidates within the same budget, and to direct computation past that
+    void setMatrixBudget(double bytes) {
+        matrixBudget = bytes > 0 ? static_cast<uint64_t>(bytes) : 0;
+        tiles.setBudget(matrixBudget);
+        refreshCandidateViews();
+    }
+
+    // Bytes held by the tile cache that stands in for an over-budget matrix
+    double getTileCacheBytes() const {
+        return static_cast<double>(tiles.byteSize());
+    }
+
+    double getMatrixBytes() const {
+        return static_cast<double>(matrix.byteSize());
+    }
+
+    // Packed dictionary footprint, excluding the pattern matrix
+    double getWordStoreBytes() const {
+        return static_cast<double>(allWords.byteSize() + possibleAnswers.byteSize() + matrixAnswers.byteSize());
+    }
+
+    // Bytes held by the constraint posting bitsets built so far
+    double getPostingBytes() const {
+        return static_cast<double>(guessPostings.byteSize() + answerPostings.byteSize());
+    }
+    
+    // Set word lists for calculations
+    void setWordLists(const std::vector<std::string>& guessWords, const std::vector<std::string>& answerWords) {
+        ENTROPY_PHASE(stats, marshalInMs);
+        // Pack the lists into contiguous letter rows
+        WordStore guesses;
+        WordStore answers;
+        guesses.assign(guessWords);
+        answers.assign(answerWords);
+        installWordLists(std::move(guesses), std::move(answers));
+    }
+
+    // Heap buffers for the binary entry points: JS fills them with HEAPU8.set(bytes, pointer)
+    uintptr_t allocateBuffer(size_t bytes) {
+        return reinterpret_cast<uintptr_t>(std::malloc(std::max<size_t>(bytes, 1)));
+    }
+
+    void freeBuffer(uintptr_t pointer) {
+        std::free(reinterpret_cast<void*>(pointer));
+    }
+
+    // Binary setWordLists: fixed-stride ASCII rows already copied into the module heap
+    void setWordListsPacked(uintptr_t guessPointer, size_t guessCount,
+                            uintptr_t answerPointer, size_t answerCount, size_t wordLength) {
+        ENTROPY_PHASE(stats, marshalInMs);
+        WordStore guesses;
+        WordStore answers;
+        guesses.assignPacked(reinterpret_cast<const uint8_t*>(guessPointer), guessCount, wordLength);
+        answers.assignPacked(reinterpret_cast<const uint8_t*>(answerPointer), answerCount, wordLength);
+        installWordLists(std::move(guesses), std::move(answers));
+    }
+
+    // Loads a binary dictionary as both the guess and answer list; returns the word count or -1
+    int setDictionaryBinary(uintptr_t pointer, size_t bytes) {
+        ENTROPY_PHASE(stats, marshalInMs);
+        WordStore guesses;
+        if (!guesses.assignDictionary(reinterpret_cast<const uint8_t*>(pointer), bytes)) {
+            return -1;
+        }
+        WordStore answers = guesses;
+        installWordLists(std::move(guesses), std::move(answers));
+        return static_cast<int>(allWords.size());
+    }
+
+    // Prior weight per possibleAnswers row (Float32 values in the module heap), e.g. word
+    // frequencies: entropies become weighted Shannon entropies over the answers. Weights are
+    // relative and scaled to integers; non-positive ones count as the smallest weight. Cleared
+    // by the next setWordLists*; returns false (and leaves the answers uniform) on a count mismatch.
+    bool setAnswerPriors(uintptr_t weightsPointer, size_t count) {
+        answerWeights.clear();
+        bool accepted = count == possibleAnswers.size() && count > 0 && !streaming;
+        if (accepted) {
+            const float* weights = reinterpret_cast<const float*>(weightsPointer);
+            float largest = 0.0f;
+            for (size_t i = 0; i < count; i++) {
+                if (weights[i] > largest) largest = weights[i];
+            }
+            accepted = largest > 0.0f && std::isfinite(largest);
+            if (accepted) {
+                // Keeps every histogram total within 32 bits
+                double scale = std::min<double>(PRIOR_SCALE, UINT32_MAX / count) / largest;
+                answerWeights.resize(count);
+                for (size_t i = 0; i < count; i++) {
+                    double weight = weights[i] > 0.0f ? std::floor(weights[i] * scale + 0.5) : 0.0;
+                    answerWeights[i] = static_cast<uint32_t>(std::max(weight, 1.0));
+                }
+            }
+        }
+        refreshListHashes();
+        refreshCandidateViews();
+        return accepted;
+    }
+
+    void clearAnswerPriors() {
+        setAnswerPriors(0, 0);
+    }
+
+    bool hasAnswerPriors() const {
+        return !answerWeights.empty();
+    }
+
+    // Ranks every guess into the result buffers; returns the result count.
+    // Read getResultIndices/getResultEntropies before the next call that can grow memory.
+    int calculateAllEntropiesPacked() {
+        if (candidates.size() == 0) {
+            return storeResults({});
+        }
+        return storeResults(rankAllGuesses());
+    }
+
+    // Best k guesses only, into the result buffers: no full sort and no per-word JS objects.
+    // Returns the result count; read getResultIndices/getResultEntropies for the ranking.
+    int calculateTopEntropies(int k) {
+        if (candidates.size() == 0 || k <= 0) {
+            return storeResults({});
+        }
+        return storeResults(rankCached(static_cast<size_t>(k)));
+    }
+
+    // Ranking cache byte cap; 0 disables caching and drops the stored rankings
+    void setCacheBudget(double bytes) {
+        rankingCache.setBudget(bytes > 0 ? static_cast<size_t>(bytes) : 0);
+    }
+
+    void clearCache() {
+        rankingCache.clear();
+        rankingCache.resetCounters();
+    }
+
+    // Counters and phase timings since construction or resetStats (cache counters since clearCache)
+    EngineStats getStats() const {
+        EngineStats snapshot;
+#if ENTROPY_ENABLE_STATS
+        snapshot = stats;
+#endif
+        snapshot.cacheHits = rankingCache.hitCount();
+        snapshot.cacheMisses = rankingCache.missCount();
+        snapshot.tileHits = tiles.hitCount();
+        snapshot.tileMisses = tiles.missCount();
+        snapshot.tileBytes = tiles.byteSize();
+        snapshot.scratchBytes = scratch.reservedBytes();
+        snapshot.scratchBlocks = scratch.blockCount();
+        return snapshot;
+    }
+
+    void resetStats() {
+#if ENTROPY_ENABLE_STATS
+        stats = EngineStats();
+#endif
+        tiles.resetCounters();
+    }
+
+#if ENTROPY_ENABLE_STATS
+    // For the binding layer's own marshalling phases
+    EngineStats& mutableStats() {
+        return stats;
+    }
+#endif
+
+    int getCacheHits() const {
+        return static_cast<int>(rankingCache.hitCount());
+    }
+
+    int getCacheMisses() const {
+        return static_cast<int>(rankingCache.missCount());
+    }
+
+    double getCacheBytes() const {
+        return static_cast<double>(rankingCache.byteSize());
+    }
+
+    int getCacheEntries() const {
+        return static_cast<int>(rankingCache.size());
+    }
+
+    // Branch-and-bound top-k (on by default); rankings are identical either way
+    void setPruningEnabled(bool enabled) {
+        pruningEnabled = enabled;
+    }
+
+    bool isPruningEnabled() const {
+        return pruningEnabled;
+    }
+
+    // Guesses scored exactly by the last ranking call; below the guess count when pruning skipped some
+    int getLastScoredGuesses() const {
+        return static_cast<int>(lastScoredGuesses);
+    }
+
+    // Starts a time-sliced ranking of the best k guesses (k <= 0 ranks every guess) over the
+    // current candidates. Drive it with stepRankingJob and collect it with finishRankingJob;
+    // any change to the word lists or candidates makes the job stale and it stops.
+    void beginRankingJob(int k) {
+#if ENTROPY_ENABLE_STATS
+        stats.rankings++;
+#endif
+        jobCancel.store(0, std::memory_order_relaxed);
+        job = RankingJob();
+        job.active = true;
+        job.generation = candidateGeneration;
+        job.total = guessCount();
+        job.limit = k > 0 ? std::min(static_cast<size_t>(k), job.total) : job.total;
+        if (candidates.size() == 0 || job.limit == 0) {
+            job.done = true;
+            return;
+        }
+
+        if (!streaming && rankingCache.enabled()) {
+            job.cacheKey = candidateKey();
+            if (const std::vector<RankedGuess>* cached = rankingCache.find(job.cacheKey, candidates.size(), job.limit)) {
+                job.ranked.assign(cached->begin(), cached->begin() + std::min(job.limit, cached->size()));
+                job.done = true;
+                return;
+            }
+        }
+
+        job.order.resize(job.total);
+        for (size_t i = 0; i < job.order.size(); i++) job.order[i] = guessRow(i);
+        job.pruned = canPrune(job.limit);
+        if (job.pruned) {
+            entropyBounds(job.bounds);
+            std::sort(job.order.begin(), job.order.end(), [&](uint32_t a, uint32_t b) {
+                return job.bounds[a] > job.bounds[b] || (job.bounds[a] == job.bounds[b] && a < b);
+            });
+        }
+    }
+
+    // Scores chunks until `sliceMs` has elapsed (at least one chunk), checking the cancel token
+    // between chunks. Returns the guesses scored so far, or -1 when cancelled or stale.
+    int stepRankingJob(double sliceMs) {
+        if (!jobCurrent() || jobCancel.load(std::memory_order_relaxed) != 0) {
+            job.active = false;
+            return -1;
+        }
+        auto sliceEnd = std::chrono::steady_clock::now() +
+            std::chrono::microseconds(static_cast<int64_t>(sliceMs * 1000.0));
+        while (!job.done) {
+            stepRankingChunk();
+            if (jobCancel.load(std::memory_order_relaxed) != 0) {
+                job.active = false;
+                return -1;
+            }
+            if (std::chrono::steady_clock::now() >= sliceEnd) break;
+        }
+        return static_cast<int>(job.done ? job.total : job.next);
+    }
+
+    bool isRankingJobDone() const {
+        return jobCurrent() && job.done;
+    }
+
+    // Guesses scored so far and the total, for progress; a pruned job jumps to the total when done
+    int getRankingJobProgress() const {
+        return static_cast<int>(job.done ? job.total : job.next);
+    }
+
+    int getRankingJobTotal() const {
+        return static_cast<int>(job.total);
+    }
+
+    void cancelRankingJob() {
+        jobCancel.store(1, std::memory_order_relaxed);
+    }
+
+    // Cancel token for another thread: Atomics.store(HEAP32, pointer >> 2, 1)
+    uintptr_t getJobCancelPointer() {
+        return reinterpret_cast<uintptr_t>(&jobCancel);
+    }
+
+    // Stores the finished ranking in the result buffers (and the ranking cache); returns the
+    // result count, or -1 if the job is unfinished, cancelled or stale
+    int finishRankingJob() {
+        if (!isRankingJobDone()) {
+            return -1;
+        }
+        job.active = false;
+        {
+            ENTROPY_PHASE(stats, sortMs);
+            std::sort(job.ranked.begin(), job.ranked.end(), rankedBefore);
+        }
+        if (job.cacheKey != 0 && !job.order.empty()) {
+            lastScoredGuesses = job.next;
+            rankingCache.store(job.cacheKey, candidates.size(), job.ranked, job.limit >= job.total);
+        }
+        return storeResults(job.ranked);
+    }
+
+    // Lookahead depth in guesses (1 = one-step expected guesses), root breadth, and time budget
+    void setSolverDepth(int depth) {
+        solverDepth = std::max(1, depth);
+    }
+
+    void setSolverBreadth(int breadth) {
+        solverBreadth = std::max(1, breadth);
+    }
+
+    void setSolverTimeBudget(double milliseconds) {
+        solverBudgetMs = milliseconds;
+    }
+
+    // Stops a running solveLookahead at its next check; from another thread, Atomics.store(HEAP32,
+    // getCancelFlagPointer() >> 2, 1) does the same. The flag clears when the next solve starts.
+    void cancelSolve() {
+        solverCancel.store(1, std::memory_order_relaxed);
+    }
+
+    uintptr_t getCancelFlagPointer() {
+        return reinterpret_cast<uintptr_t>(&solverCancel);
+    }
+
+    // Scores the top entropy guesses by expected guesses to solve the current candidates and keeps
+    // the best k, fewest expected guesses first: indices in getResultIndices, expected guesses in
+    // getResultScores, one-step entropies in getResultEntropies. Guesses not reached before the
+    // budget or a cancel are left out; isSolveComplete reports whether every one was evaluated.
+    int solveLookahead(int k) {
+        resultScores.clear();
+        solverComplete = true;
+        solverCancel.store(0, std::memory_order_relaxed);
+        if (candidates.size() == 0 || k <= 0 || allWords.wordLength() != possibleAnswers.wordLength()) {
+            return storeResults({});
+        }
+        solverDeadline = std::chrono::steady_clock::now() +
+            std::chrono::microseconds(static_cast<int64_t>(solverBudgetMs * 1000.0));
+
+        std::vector<uint32_t> answers;
+        candidates.forEach([&](size_t row) { answers.push_back(static_cast<uint32_t>(row)); });
+        std::vector<RankedGuess> roots = rankCached(static_cast<size_t>(solverBreadth));
+
+        // (expected guesses, entropy rank) for every root evaluated in time
+        std::vector<std::pair<double, size_t>> evaluated;
+        for (size_t i = 0; i < roots.size(); i++) {
+            if (i > 0 && solverStopped()) break;
+            double expected = expectedAfterGuess(roots[i].second, answers, solverDepth - 1);
+            // A root whose subtree was cut short is only an estimate; keep it if it is the sole one
+            if (!solverComplete && !evaluated.empty()) break;
+            evaluated.push_back({expected, i});
+        }
+
+        std::sort(evaluated.begin(), evaluated.end());
+        evaluated.resize(std::min(evaluated.size(), static_cast<size_t>(k)));
+        std::vector<RankedGuess> ranked;
+        for (const auto& entry : evaluated) {
+            ranked.push_back(roots[entry.second]);
+            resultScores.push_back(static_cast<float>(entry.first));
+        }
+        return storeResults(ranked);
+    }
+
+    bool isSolveComplete() const {
+        return solverComplete;
+    }
+
+    // Expected guesses matching getResultIndices after solveLookahead
+    const std::vector<float>& getResultScores() const {
+        return resultScores;
+    }
+
+    // Offline opening book over the current lists (see the format above): ranks the best
+    // `openerCount` first guesses, then for the first `followUps` of them partitions the answers
+    // by feedback and ranks the best second guess in each partition of three or more answers.
+    // Candidates are reset after.
+    // Returns the table size in bytes; read it with getOpeningTable.
+    int buildOpeningTable(int openerCount, int followUps) {
+        openingTable.clear();
+        size_t length = allWords.wordLength();
+        if (length == 0 || length != possibleAnswers.wordLength() || openerCount <= 0) {
+            return 0;
+        }
+
+        resetCandidateState();
+        std::vector<RankedGuess> openers = rankTopGuesses(static_cast<size_t>(openerCount));
+        size_t followUpCount = std::min(openers.size(), static_cast<size_t>(std::max(followUps, 0)));
+
+        openingTable.insert(openingTable.end(), {'W', 'D', 'L', 'O', OPENING_TABLE_VERSION,
+                                                 static_cast<uint8_t>(length)});
+        appendLE(openingTable, openers.size(), 2);
+        appendLE(openingTable, followUpCount, 2);
+        appendLE(openingTable, 0, 2);
+        appendLE(openingTable, possibleAnswers.size(), 4);
+        for (const RankedGuess& opener : openers) {
+            appendWordBytes(allWords.word(opener.second));
+            appendFloat(openingTable, static_cast<float>(opener.first));
+        }
+
+        for (size_t o = 0; o < followUpCount; o++) {
+            const uint8_t* opener = allWords.row(openers[o].second);
+            std::vector<std::pair<PatternCode, uint32_t>> feedback(possibleAnswers.size());
+            for (size_t a = 0; a < possibleAnswers.size(); a++) {
+                feedback[a] = {computePatternCode(opener, possibleAnswers.row(a), length), static_cast<uint32_t>(a)};
+            }
+            std::sort(feedback.begin(), feedback.end());
+
+            size_t patternCountAt = openingTable.size();
+            appendLE(openingTable, 0, 4);
+            uint32_t patternCount = 0;
+            std::vector<uint32_t> partition;
+            for (size_t begin = 0; begin < feedback.size();) {
+                size_t end = begin;
+                partition.clear();
+                while (end < feedback.size() && feedback[end].first == feedback[begin].first) {
+                    partition.push_back(feedback[end++].second);
+                }
+
+                // Two or fewer answers: guessing one of them is already optimal, so leave them out
+                if (partition.size() <= 2) {
+                    begin = end;
+                    continue;
+                }
+                candidates.select(possibleAnswers.size(), partition);
+                refreshCandidateViews();
+                std::vector<RankedGuess> best = rankTopGuesses(1);
+
+                appendLE(openingTable, feedback[begin].first, 8);
+                appendLE(openingTable, partition.size(), 4);
+                if (best.empty()) {
+                    appendFloat(openingTable, -1.0f);
+                    appendWordBytes(possibleAnswers.word(partition.front()));
+                } else {
+                    appendFloat(openingTable, static_cast<float>(best.front().first));
+                    appendWordBytes(allWords.word(best.front().second));
+                }
+                patternCount++;
+                begin = end;
+            }
+            for (size_t i = 0; i < 4; i++) {
+                openingTable[patternCountAt + i] = static_cast<uint8_t>(patternCount >> (8 * i));
+            }
+        }
+
+        resetCandidateState();
+        return static_cast<int>(openingTable.size());
+    }
+
+    // The last buildOpeningTable output
+    const std::vector<uint8_t>& getOpeningTable() const {
+        return openingTable;
+    }
+
+    // Snapshots the word lists, priors, pattern matrix and opening table (format above) into
+    // the state buffer; returns its size in bytes, 0 while streaming. Tiles, the ranking cache
+    // and feedback are left out: they follow the candidates and refill during play.
+    int serializeState() {
+        stateBuffer.clear();
+        if (streaming) {
+            return 0;
+        }
+        bool hasMatrix = !matrix.empty() && matrix.rowCount() == allWords.size() &&
+                         activeColumns.size() == possibleAnswers.size();
+        uint8_t flags = (answerWeights.empty() ? 0 : STATE_HAS_PRIORS) | (hasMatrix ? STATE_HAS_MATRIX : 0) |
+                        (openingTable.empty() ? 0 : STATE_HAS_OPENINGS);
+        stateBuffer.reserve(STATE_HEADER_BYTES + 64 + allWords.byteSize() + possibleAnswers.byteSize() +
+                            answerWeights.size() * sizeof(uint32_t) + openingTable.size() +
+                            (hasMatrix ? matrixAnswers.byteSize() + activeColumns.size() * sizeof(uint32_t) + matrix.byteSize() : 0));
+        stateBuffer.insert(stateBuffer.end(), {'W', 'D', 'L', 'S', STATE_VERSION, flags, 0, 0});
+        appendLE(stateBuffer, 0, 8);
+
+        allWords.appendState(stateBuffer);
+        possibleAnswers.appendState(stateBuffer);
+        appendBytes(stateBuffer, answerWeights.data(), answerWeights.size() * sizeof(uint32_t));
+        if (hasMatrix) {
+            matrixAnswers.appendState(stateBuffer);
+            appendLE(stateBuffer, activeColumns.size(), 4);
+            appendBytes(stateBuffer, activeColumns.data(), activeColumns.size() * sizeof(uint32_t));
+            appendBytes(stateBuffer, matrix.cellData(), matrix.byteSize());
+        }
+        if (!openingTable.empty()) {
+            appendLE(stateBuffer, openingTable.size(), 4);
+            appendBytes(stateBuffer, openingTable.data(), openingTable.size());
+        }
+
+        uint64_t hash = hashWords(stateBuffer.data() + STATE_HEADER_BYTES, stateBuffer.size() - STATE_HEADER_BYTES);
+        for (size_t i = 0; i < 8; i++) stateBuffer[8 + i] = static_cast<uint8_t>(hash >> (8 * i));
+        return static_cast<int>(stateBuffer.size());
+    }
+
+    // The last serializeState output
+    const std::vector<uint8_t>& getStateBuffer() const {
+        return stateBuffer;
+    }
+
+    // Frees the state buffer once the snapshot has been copied out; it can be as large as the matrix
+    void releaseStateBuffer() {
+        std::vector<uint8_t>().swap(stateBuffer);
+    }
+
+    // Installs a serializeState snapshot from the module heap in place of setWordLists*: rows,
+    // masks and matrix cells are copied in without repacking or recomputing patterns. A matrix
+    // turns matrix mode on, unless it is over the current budget, when it is dropped. Returns
+    // false, leaving the engine untouched, when the snapshot is corrupt or from another version.
+    bool restoreState(uintptr_t pointer, size_t bytes) {
+        ENTROPY_PHASE(stats, marshalInMs);
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(pointer);
+        if (bytes < STATE_HEADER_BYTES || std::memcmp(data, "WDLS", 4) != 0 || data[4] != STATE_VERSION) {
+            return false;
+        }
+        StateReader reader{data, bytes, 8};
+        uint64_t hash = 0;
+        reader.readLE(hash, 8);
+        if (hash != hashWords(data + STATE_HEADER_BYTES, bytes - STATE_HEADER_BYTES)) {
+            return false;
+        }
+
+        uint8_t flags = data[5];
+        WordStore guesses;
+        WordStore answers;
+        if (!guesses.restoreState(reader) || !answers.restoreState(reader) ||
+            (!answers.empty() && !guesses.empty() && answers.wordLength() != guesses.wordLength())) {
+            return false;
+        }
+        std::vector<uint32_t> weights;
+        if (flags & STATE_HAS_PRIORS) {
+            weights.resize(answers.size());
+            if (!reader.read(weights.data(), weights.size() * sizeof(uint32_t))) return false;
+        }
+
+        WordStore columnsAnswers;
+        std::vector<uint32_t> columns;
+        PatternMatrix cells;
+        if (flags & STATE_HAS_MATRIX) {
+            uint64_t columnCount = 0;
+            if (!columnsAnswers.restoreState(reader) || columnsAnswers.wordLength() != guesses.wordLength() ||
+                !reader.readLE(columnCount, 4) || columnCount != answers.size()) {
+                return false;
+            }
+            columns.resize(columnCount);
+            if (!reader.read(columns.data(), columns.size() * sizeof(uint32_t))) return false;
+            for (uint32_t column : columns) {
+                if (column >= columnsAnswers.size()) return false;
+            }
+            uint64_t cellBytes = PatternMatrix::bytesRequired(guesses.size(), columnsAnswers.size(), guesses.wordLength());
+            if (cellBytes == 0 || cellBytes > reader.remaining()) return false;
+            if (cellBytes <= matrixBudget) {
+                cells.resize(guesses.size(), columnsAnswers.size(), guesses.wordLength());
+                reader.read(cells.cellData(), cellBytes);
+            } else {
+                reader.offset += cellBytes;
+            }
+        }
+        std::vector<uint8_t> openings;
+        if (flags & STATE_HAS_OPENINGS) {
+            uint64_t tableBytes = 0;
+            if (!reader.readLE(tableBytes, 4) || tableBytes > reader.remaining()) return false;
+            openings.resize(tableBytes);
+            reader.read(openings.data(), openings.size());
+        }
+        if (reader.remaining() != 0) {
+            return false;
+        }
+
+        // Same order as installWordLists, with the matrix taken from the snapshot
+        streaming = false;
+        allWords = std::move(guesses);
+        possibleAnswers = std::move(answers);
+        clearPostings();
+        answerWeights = std::move(weights);
+        boards.clear();
+        boardHistory.clear();
+        kernels = &kernelsFor(possibleAnswers.wordLength());
+        if (simdEnabled) {
+            possibleAnswers.buildColumns();
+        }
+        clearMatrix();
+        if (!cells.empty()) {
+            matrixMode = true;
+            matrix = std::move(cells);
+            matrixAnswers = std::move(columnsAnswers);
+            activeColumns = std::move(columns);
+        } else if (matrixMode) {
+            buildMatrix();
+        }
+        openingTable = std::move(openings);
+        refreshListHashes();
+        refreshHardGuesses();
+        resetCandidateState();
+        return true;
+    }
+
+    // Starts streaming ingestion: clears both lists, then rows arrive through appendStream*.
+    // Feedback does not carry across chunks; candidates restart at each provisional ranking.
+    void beginStream(size_t wordLength) {
+        clearMatrix();
+        allWords.reset(wordLength);
+        possibleAnswers.reset(wordLength);
+        clearPostings();
+        answerWeights.clear();
+        boards.clear();
+        boardHistory.clear();
+        kernels = &kernelsFor(wordLength);
+        streamFiltered = 0;
+        streaming = true;
+        refreshHardGuesses();
+        resetCandidateState();
+    }
+
+    // Appends binary dictionary rows (the .bin body, no header); returns the rows loaded so far
+    int appendStreamRows(uintptr_t pointer, size_t rowCount) {
+        if (!streaming) return -1;
+        ENTROPY_PHASE(stats, marshalInMs);
+        allWords.appendDictionaryRows(reinterpret_cast<const uint8_t*>(pointer), rowCount);
+        return static_cast<int>(allWords.size());
+    }
+
+    // String chunk variant for the JSON fallback; words of another length are skipped
+    int appendStreamWords(const std::vector<std::string>& words) {
+        if (!streaming) return -1;
+        for (const std::string& word : words) {
+            if (word.length() == allWords.wordLength()) allWords.append(word);
+        }
+        return static_cast<int>(allWords.size());
+    }
+
+    // Ranks the loaded prefix against its constrained answers; the best `k` land in the
+    // result buffers. Rankings are provisional until endStream.
+    int getProvisionalTopEntropies(int k) {
+        if (!streaming) return -1;
+        extendStreamAnswers();
+        return calculateTopEntropies(k);
+    }
+
+    // Completes the stream as if setWordLists(all loaded, constrained answers) had been called
+    int endStream() {
+        if (!streaming) return -1;
+        extendStreamAnswers();
+        streaming = false;
+        refreshListHashes();
+        refreshHardGuesses();
+        if (matrixMode) {
+            buildMatrix();
+            resetCandidateState();
+        }
+        return static_cast<int>(possibleAnswers.size());
+    }
+
+    bool isStreaming() const {
+        return streaming;
+    }
+
+    // Binary filterWords over fixed-stride ASCII rows; matching row indices land in getResultIndices
+    int filterWordsPacked(uintptr_t wordsPointer, size_t wordCount, size_t wordLength,
+                          const WordConstraints& input) {
+        filterStore.assignPacked(reinterpret_cast<const uint8_t*>(wordsPointer), wordCount, wordLength);
+        filterConstraints.compile(wordLength, input);
+        resultIndices.clear();
+        matchingWords(filterStore, filterConstraints, resultIndices);
+        resultEntropies.clear();
+        return static_cast<int>(resultIndices.size());
+    }
+
+    // Guess (or filtered word) indices from the last packed call
+    const std::vector<uint32_t>& getResultIndices() const {
+        return resultIndices;
+    }
+
+    // Entropies matching getResultIndices
+    const std::vector<float>& getResultEntropies() const {
+        return resultEntropies;
+    }
+
+    std::string getGuessWord(int index) const {
+        if (index < 0 || static_cast<size_t>(index) >= allWords.size()) return "";
+        return allWords.word(static_cast<size_t>(index));
+    }
+    
+    // High-performance entropy calculation
+    double calculateEntropy(const std::string& guessWord) {
+        if (candidates.size() <= 1 || guessWord.length() != possibleAnswers.wordLength()) {
+            return 0.0;
+        }
+
+        ENTROPY_PHASE(stats, computeMs);
+        countScored(1);
+        if (isMatrixActive()) {
+            int row = allWords.find(guessWord);
+            if (row >= 0) {
+                return matrixRowEntropy(static_cast<size_t>(row), histograms[0]);
+            }
+        }
+#if ENTROPY_ENABLE_STATS
+        if (isMatrixActive()) stats.patternsComputed += candidates.size(); // guess outside the matrix
+#endif
+
+        ScratchArena::Scope scope(scratch);
+        ScratchVector<uint8_t> guess = scratchVector<uint8_t>(guessWord.length());
+        for (size_t i = 0; i < guess.size(); i++) guess[i] = letterIndex(guessWord[i]);
+        return rowEntropy(guess.data(), histograms[0]);
+    }
+    
+    // Ultra-fast bulk entropy calculation for all words: (entropy, guess index), best first
+    std::vector<RankedGuess> calculateAllEntropies() {
+        if (candidates.size() == 0) {
+            return {};
+        }
+        return rankAllGuesses();
+    }
+    
+    // Narrows the candidates to answers that would give `pattern` (G/Y/B per tile) for
+    // `guessWord`; uses the guess's matrix row when available. Returns the new count, or -1.
+    int applyFeedback(const std::string& guessWord, const std::string& pattern) {
+        size_t length = possibleAnswers.wordLength();
+        if (length == 0 || guessWord.length() != length || pattern.length() != length) {
+            return -1;
+        }
+
+        PatternCode target = encodePattern(pattern);
+        feedbackHistory.push_back(candidates);
+
+        int row = isMatrixActive() ? allWords.find(guessWord) : -1;
+        if (row >= 0) {
+            candidates.retain([&](size_t index) {
+                return matrix.at(static_cast<size_t>(row), activeColumns[index]) == target;
+            });
+        } else {
+            ScratchArena::Scope scope(scratch);
+            ScratchVector<uint8_t> guess = scratchVector<uint8_t>(length);
+            for (size_t i = 0; i < length; i++) guess[i] = letterIndex(guessWord[i]);
+            candidates.retain([&](size_t index) {
+                return computePatternCode(guess.data(), possibleAnswers.row(index), length) == target;
+            });
+        }
+
+        refreshCandidateViews(true);
+        return static_cast<int>(candidates.size());
+    }
+
+    // Restores the candidates from before the last applyFeedback (tile corrections)
+    int undoFeedback() {
+        if (!feedbackHistory.empty()) {
+            candidates = std::move(feedbackHistory.back());
+            feedbackHistory.pop_back();
+            refreshCandidateViews();
+        }
+        return static_cast<int>(candidates.size());
+    }
+
+    void resetCandidates() {
+        resetCandidateState();
+    }
+
+    int getCandidateCount() const {
+        return static_cast<int>(candidates.size());
+    }
+
+    std::vector<std::string> getCandidates() const {
+        std::vector<std::string> result;
+        result.reserve(candidates.size());
+        candidates.forEach([&](size_t index) {
+            result.push_back(possibleAnswers.word(index));
+        });
+        return result;
+    }
+
+    // The candidates as possibleAnswers rows in getResultIndices, without building strings;
+    // returns their count
+    int getCandidateIndices() {
+        resultIndices.clear();
+        resultEntropies.clear();
+        resultIndices.reserve(candidates.size());
+        candidates.forEach([&](size_t index) { resultIndices.push_back(static_cast<uint32_t>(index)); });
+        return static_cast<int>(resultIndices.size());
+    }
+
+    // Multi-board API: `count` boards over the current answers, each starting with every answer.
+    // Cleared by the next setWordLists* or beginStream.
+    void setBoardCount(int count) {
+        boards.assign(static_cast<size_t>(std::max(count, 0)), CandidateSet());
+        for (CandidateSet& board : boards) board.fill(possibleAnswers.size());
+        boardHistory.assign(boards.size(), {});
+    }
+
+    int getBoardCount() const {
+        return static_cast<int>(boards.size());
+    }
+
+    // applyFeedback for one board; returns its new candidate count, or -1
+    int applyBoardFeedback(int board, const std::string& guessWord, const std::string& pattern) {
+        size_t length = possibleAnswers.wordLength();
+        if (board < 0 || static_cast<size_t>(board) >= boards.size() || length == 0 ||
+            guessWord.length() != length || pattern.length() != length) {
+            return -1;
+        }
+
+        PatternCode target = encodePattern(pattern);
+        CandidateSet& candidateBoard = boards[board];
+        boardHistory[board].push_back(candidateBoard);
+        ScratchArena::Scope scope(scratch);
+        ScratchVector<uint8_t> guess = scratchVector<uint8_t>(length);
+        for (size_t i = 0; i < length; i++) guess[i] = letterIndex(guessWord[i]);
+        candidateBoard.retain([&](size_t index) {
+            return computePatternCode(guess.data(), possibleAnswers.row(index), length) == target;
+        });
+        return static_cast<int>(candidateBoard.size());
+    }
+
+    int undoBoardFeedback(int board) {
+        if (board < 0 || static_cast<size_t>(board) >= boards.size()) return -1;
+        if (!boardHistory[board].empty()) {
+            boards[board] = std::move(boardHistory[board].back());
+            boardHistory[board].pop_back();
+        }
+        return static_cast<int>(boards[board].size());
+    }
+
+    void resetBoards() {
+        setBoardCount(static_cast<int>(boards.size()));
+    }
+
+    int getBoardCandidateCount(int board) const {
+        if (board < 0 || static_cast<size_t>(board) >= boards.size()) return -1;
+        return static_cast<int>(boards[board].size());
+    }
+
+    std::vector<std::string> getBoardCandidates(int board) const {
+        std::vector<std::string> result;
+        if (board < 0 || static_cast<size_t>(board) >= boards.size()) return result;
+        boards[board].forEach([&](size_t index) { result.push_back(possibleAnswers.word(index)); });
+        return result;
+    }
+
+    // Best k guesses by entropy summed over the boards (hard mode applies), into the result
+    // buffers; boards down to one candidate add nothing. Returns the result count.
+    int calculateBoardTopEntropies(int k) {
+        if (k <= 0 || streaming) {
+            return storeResults({});
+        }
+        refreshBoardViews();
+        return storeResults(rankBoardGuesses(static_cast<size_t>(k)));
+    }
+
+    // Fast word filtering with constraints
+    std::vector<std::string> filterWords(const std::vector<std::string>& wordList, const WordConstraints& input) {
+        std::vector<std::string> result;
+        filterWordsEach(wordList.size(), [&](size_t i) -> const std::string& { return wordList[i]; }, input,
+                        [&](const std::string& word) { result.push_back(word); });
+        return result;
+    }
+
+    // filterWords without the list copies: `wordAt(i)` yields word i and `emit` receives each
+    // match, so the bindings read and fill JS arrays directly. Steady state allocates nothing
+    // beyond `emit`'s own work (words up to 15 letters fit std::string's inline buffer).
+    template <typename WordAt, typename Emit>
+    void filterWordsEach(size_t wordCount, const WordAt& wordAt, const WordConstraints& input, const Emit& emit) {
+        ScratchArena::Scope scope(scratch);
+        filterStore.reset(wordCount == 0 ? 0 : wordAt(0).length());
+        for (size_t i = 0; i < wordCount; i++) filterStore.append(wordAt(i));
+        filterConstraints.compile(filterStore.wordLength(), input);
+
+        ScratchVector<uint32_t> matches = scratchVector<uint32_t>();
+        matches.reserve(filterStore.size());
+        matchingWords(filterStore, filterConstraints, matches);
+        for (uint32_t index : matches) emit(filterStore.word(index));
+    }
+
+    // Reusable holder for constraints arriving from the bindings; refilling it in place keeps
+    // its vectors' capacity between calls
+    WordConstraints& constraintScratch() {
+        return constraintInput;
+    }
+
+    // Compiles constraints once for filterDictionary
+    void setConstraints(const WordConstraints& input) {
+        constraints.compile(allWords.wordLength(), input);
+        if (streaming) {
+            // Re-filter the loaded prefix on the next provisional ranking
+            possibleAnswers.reset(allWords.wordLength());
+            streamFiltered = 0;
+            clearPostings();
+        }
+        if (hardMode) refreshHardGuesses();
+    }
+
+    // Hard mode limits every ranking (and the lookahead roots) to guesses that reuse the hints
+    // of the last setConstraints; the answers are unaffected.
+    void setHardMode(bool enabled) {
+        if (hardMode == enabled) return;
+        hardMode = enabled;
+        refreshHardGuesses();
+    }
+
+    bool isHardMode() const {
+        return hardMode;
+    }
+
+    // Guesses a ranking walks: the hard-mode allowed rows, or every guess
+    int getAllowedGuessCount() const {
+        return static_cast<int>(guessCount());
+    }
+
+    // Words of the stored dictionary matching the compiled constraints, without re-sending it
+    std::vector<std::string> filterDictionary() {
+        std::vector<std::string> result;
+        filterDictionaryEach([&](const std::string& word) { result.push_back(word); });
+        return result;
+    }
+
+    template <typename Emit>
+    void filterDictionaryEach(const Emit& emit) {
+        if (constraints.wordLength() != allWords.wordLength()) {
+            return;
+        }
+        constrainedRows(guessPostings, allWords).forEach([&](size_t index) { emit(allWords.word(index)); });
+    }
+
+    // Number of dictionary words matching the compiled constraints, from popcounts alone
+    int countDictionaryMatches() {
+        if (constraints.wordLength() != allWords.wordLength()) {
+            return 0;
+        }
+        return static_cast<int>(constrainedRows(guessPostings, allWords).size());
+    }
+
+    // filterDictionary as dictionary indices in getResultIndices; returns the match count
+    int filterDictionaryPacked() {
+        resultIndices.clear();
+        resultEntropies.clear();
+        if (constraints.wordLength() != allWords.wordLength()) {
+            return 0;
+        }
+        const CandidateSet& matches = constrainedRows(guessPostings, allWords);
+        resultIndices.reserve(matches.size());
+        matches.forEach([&](size_t index) { resultIndices.push_back(static_cast<uint32_t>(index)); });
+        return static_cast<int>(resultIndices.size());
+    }
+
+    // Narrows the candidates to the answers matching the compiled constraints, in place of
+    // sending the filtered answers back as a new list; undoFeedback reverts it. Returns the
+    // candidate count, or -1 when the constraints are for another length.
+    int applyConstraints() {
+        if (constraints.wordLength() != possibleAnswers.wordLength() || possibleAnswers.empty()) {
+            return -1;
+        }
+        feedbackHistory.push_back(candidates);
+        candidates.intersect(constrainedRows(answerPostings, possibleAnswers));
+        refreshCandidateViews(true);
+        return static_cast<int>(candidates.size());
+    }
+};
@@ -0,0 +1,87 @@
+// Helpers shared by the native drivers (benchmark.cpp, solver.cpp): dictionary loading, timing,
+// and game feedback in the shapes the engine takes from JavaScript.
+#pragma once
+
+#include "entropy_engine.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace native_tools {
+
+typedef std::chrono::steady_clock Clock;
+
+inline double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// The dictionaries are flat JSON arrays of strings without escapes
+inline bool loadWords(const std::string& path, std::vector<std::string>& words) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+    words.clear();
+    for (size_t open = text.find('"'); open != std::string::npos; open = text.find('"', open + 1)) {
+        size_t close = text.find('"', open + 1);
+        if (close == std::string::npos) return false;
+        words.push_back(text.substr(open + 1, close - open - 1));
+        open = close;
+    }
+    return !words.empty();
+}
+
+inline std::string dictionaryPath(const std::string& wordsDir, int length) {
+    return wordsDir + "/words_" + std::to_string(length) + "_letters.json";
+}
+
+inline std::vector<int> parseLengths(const std::string& list) {
+    std::vector<int> lengths;
+    std::stringstream stream(list);
+    for (std::string item; std::getline(stream, item, ',');) lengths.push_back(std::atoi(item.c_str()));
+    return lengths;
+}
+
+// G/Y/B tiles `guess` gets against `secret`, as applyFeedback takes them
+inline std::string feedbackFor(const std::string& guess, const std::string& secret) {
+    size_t length = guess.length();
+    std::vector<uint8_t> rows(2 * length);
+    for (size_t i = 0; i < length; i++) {
+        rows[i] = letterIndex(guess[i]);
+        rows[length + i] = letterIndex(secret[i]);
+    }
+    return decodePattern(computePatternCode(rows.data(), rows.data() + length, length), length);
+}
+
+// Feedback of `guesses` against `secret` in the shape App.tsx builds from the tiles
+inline WordConstraints constraintsFor(const std::vector<std::string>& guesses, const std::string& secret) {
+    size_t length = secret.length();
+    WordConstraints constraints;
+    constraints.knownPositions.assign(length, "");
+    std::unordered_map<char, size_t> yellowIndex;
+    for (const std::string& guess : guesses) {
+        for (size_t i = 0; i < length; i++) {
+            char letter = guess[i];
+            if (secret[i] == letter) {
+                constraints.knownPositions[i] = std::string(1, letter);
+            } else if (secret.find(letter) != std::string::npos) {
+                auto found = yellowIndex.find(letter);
+                if (found == yellowIndex.end()) {
+                    found = yellowIndex.emplace(letter, constraints.yellowLetters.size()).first;
+                    constraints.yellowLetters.push_back({std::string(1, letter), {}});
+                }
+                constraints.yellowLetters[found->second].excludedPositions.push_back(static_cast<int>(i));
+            } else {
+                std::string gray(1, letter);
+                if (std::find(constraints.grayLetters.begin(), constraints.grayLetters.end(), gray) ==
+                    constraints.grayLetters.end()) {
+                    constraints.grayLetters.push_back(gray);
+                }
+            }
+        }
+    }
+    return constraints;
+}
+
+} // namespace native_tools
@@ -0,0 +1,239 @@
+// Native batch solver for the entropy engine (no Emscripten): plays every answer of each
+// public/words_N_letters.json with a guessing strategy and reports the guess distribution and
+// throughput as one JSON object per length. Games run in parallel on std::threads, one
+// EntropyCalculator each; the opener is ranked once per length and shared.
+//
+//   npm run solve:native -- [--words-dir public] [--lengths 5,6] [--strategy entropy|lookahead]
+//       [--hard] [--threads N] [--answers N] [--opener WORD] [--max-guesses 6]
+//       [--depth 2] [--breadth 10]
+//
+// With --openings DIR it instead writes DIR/openings_N_letters.bin, the tables
+// scripts/build-opening-tables.mjs builds with the Node engine.
+
+#include "native_tools.h"
+
+#include <cstdio>
+
+namespace {
+
+using namespace native_tools;
+
+// Same settings as scripts/build-opening-tables.mjs
+constexpr int OPENER_COUNT = 12;
+constexpr int FOLLOW_UP_OPENERS = 1;
+
+// A game still unsolved after this many guesses is stopped and counted as failed
+constexpr int TURN_LIMIT = 64;
+
+struct Options {
+    std::string wordsDir = "public";
+    std::vector<int> lengths;   // empty: every dictionary found
+    std::string strategy = "entropy";
+    bool hard = false;
+    int threads = 0;            // 0: hardware concurrency
+    size_t answers = 0;         // 0: every word
+    std::string opener;         // empty: the strategy's own first guess
+    int maxGuesses = 6;         // games above this count as failed
+    int depth = 2;              // lookahead only
+    int breadth = 10;
+    std::string openingsDir;
+};
+
+void configure(EntropyCalculator& calculator, const Options& options, const std::vector<std::string>& words) {
+    calculator.setWordLists(words, words);
+    calculator.setHardMode(options.hard);
+    calculator.setSolverDepth(options.depth);
+    calculator.setSolverBreadth(options.breadth);
+    calculator.setSolverTimeBudget(1e12); // results must not depend on machine speed
+}
+
+// The strategy's next guess for the current candidates; a candidate once at most two remain
+std::string nextGuess(EntropyCalculator& calculator, const Options& options) {
+    if (calculator.getCandidateCount() <= 2) {
+        return calculator.getCandidates().front();
+    }
+    int found = options.strategy == "lookahead" ? calculator.solveLookahead(1) : calculator.calculateTopEntropies(1);
+    if (found <= 0) {
+        return calculator.getCandidates().front();
+    }
+    return calculator.getGuessWord(static_cast<int>(calculator.getResultIndices()[0]));
+}
+
+// Guesses needed to solve `secret`, or TURN_LIMIT + 1 when stopped
+int playGame(EntropyCalculator& calculator, const Options& options, const std::string& opener,
+             const std::string& secret) {
+    calculator.resetCandidates();
+    std::vector<std::string> guesses;
+    if (options.hard) calculator.setConstraints(WordConstraints());
+    for (int turn = 1; turn <= TURN_LIMIT; turn++) {
+        std::string guess = turn == 1 ? opener : nextGuess(calculator, options);
+        if (guess == secret) return turn;
+        if (calculator.applyFeedback(guess, feedbackFor(guess, secret)) <= 0) break;
+        if (options.hard) {
+            guesses.push_back(guess);
+            calculator.setConstraints(constraintsFor(guesses, secret));
+        }
+    }
+    return TURN_LIMIT + 1;
+}
+
+// Deterministic spread of `count` answers (all of them when count is 0)
+std::vector<size_t> answerRows(size_t wordCount, size_t count) {
+    std::vector<size_t> rows;
+    if (count == 0 || count >= wordCount) {
+        for (size_t i = 0; i < wordCount; i++) rows.push_back(i);
+        return rows;
+    }
+    for (size_t i = 0; i < count; i++) rows.push_back(i * wordCount / count);
+    return rows;
+}
+
+void solveDictionary(const std::vector<std::string>& words, const Options& options) {
+    size_t length = words[0].length();
+    auto start = Clock::now();
+
+    std::string opener = options.opener;
+    if (opener.empty()) {
+        EntropyCalculator calculator;
+        if (options.threads > 0) calculator.setThreadCount(options.threads);
+        configure(calculator, options, words);
+        opener = nextGuess(calculator, options);
+    }
+    for (char& c : opener) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    if (opener.length() != length) {
+        std::fprintf(stderr, "opener %s does not have %zu letters\n", opener.c_str(), length);
+        return;
+    }
+
+    std::vector<size_t> rows = answerRows(words.size(), options.answers);
+    std::vector<int> turns(rows.size());
+    std::atomic<size_t> next{0};
+    size_t threadCount = options.threads > 0 ? static_cast<size_t>(options.threads)
+                                             : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, std::max<size_t>(rows.size(), 1));
+
+    // Each thread plays whole games on its own calculator, whose ranking cache also
+    // memoizes the positions its games share
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&]() {
+            EntropyCalculator calculator;
+            calculator.setThreadCount(1);
+            configure(calculator, options, words);
+            for (size_t game = next.fetch_add(1); game < rows.size(); game = next.fetch_add(1)) {
+                turns[game] = playGame(calculator, options, opener, words[rows[game]]);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    double seconds = secondsSince(start);
+
+    std::vector<size_t> distribution;
+    size_t failed = 0;
+    uint64_t total = 0;
+    int worst = 0;
+    for (int count : turns) {
+        if (count > options.maxGuesses) failed++;
+        if (static_cast<size_t>(count) > distribution.size()) distribution.resize(count);
+        distribution[count - 1]++;
+        total += count;
+        worst = std::max(worst, count);
+    }
+    std::string histogram;
+    for (size_t i = 0; i < distribution.size(); i++) {
+        histogram += (i > 0 ? "," : "") + std::to_string(distribution[i]);
+    }
+
+    std::printf("{\"length\":%zu,\"words\":%zu,\"answers\":%zu,\"strategy\":\"%s\",\"hard\":%s,\"opener\":\"%s\","
+                "\"average_guesses\":%.4f,\"max_guesses\":%d,\"failed\":%zu,\"distribution\":[%s],"
+                "\"seconds\":%.3f,\"games_per_second\":%.1f,\"threads\":%zu}\n",
+                length, words.size(), rows.size(), options.strategy.c_str(), options.hard ? "true" : "false",
+                opener.c_str(), rows.empty() ? 0.0 : static_cast<double>(total) / rows.size(), worst, failed,
+                histogram.c_str(), seconds, seconds > 0 ? rows.size() / seconds : 0.0, threadCount);
+    std::fflush(stdout);
+}
+
+bool writeOpeningTable(const std::vector<std::string>& words, const Options& options) {
+    size_t length = words[0].length();
+    auto start = Clock::now();
+    EntropyCalculator calculator;
+    if (options.threads > 0) calculator.setThreadCount(options.threads);
+    calculator.setWordLists(words, words);
+    calculator.buildOpeningTable(OPENER_COUNT, FOLLOW_UP_OPENERS);
+    const std::vector<uint8_t>& table = calculator.getOpeningTable();
+
+    std::string path = options.openingsDir + "/openings_" + std::to_string(length) + "_letters.bin";
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size()));
+    if (!file) {
+        std::fprintf(stderr, "could not write %s\n", path.c_str());
+        return false;
+    }
+    std::printf("{\"length\":%zu,\"words\":%zu,\"op\":\"openings\",\"bytes\":%zu,\"seconds\":%.3f}\n",
+                length, words.size(), table.size(), secondsSince(start));
+    std::fflush(stdout);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        if (flag == "--hard") {
+            options.hard = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "missing value for %s\n", flag.c_str());
+            return 2;
+        }
+        std::string value = argv[++i];
+        if (flag == "--words-dir") options.wordsDir = value;
+        else if (flag == "--lengths") options.lengths = parseLengths(value);
+        else if (flag == "--strategy") options.strategy = value;
+        else if (flag == "--threads") options.threads = std::atoi(value.c_str());
+        else if (flag == "--answers") options.answers = static_cast<size_t>(std::atol(value.c_str()));
+        else if (flag == "--opener") options.opener = value;
+        else if (flag == "--max-guesses") options.maxGuesses = std::atoi(value.c_str());
+        else if (flag == "--depth") options.depth = std::atoi(value.c_str());
+        else if (flag == "--breadth") options.breadth = std::atoi(value.c_str());
+        else if (flag == "--openings") options.openingsDir = value;
+        else {
+            std::fprintf(stderr, "unknown option %s\n", flag.c_str());
+            return 2;
+        }
+    }
+    if (options.strategy != "entropy" && options.strategy != "lookahead") {
+        std::fprintf(stderr, "unknown strategy %s (entropy, lookahead)\n", options.strategy.c_str());
+        return 2;
+    }
+
+    std::vector<int> lengths = options.lengths;
+    if (lengths.empty()) {
+        for (int length = 1; length <= 32; length++) lengths.push_back(length);
+    }
+
+    int loaded = 0;
+    std::vector<std::string> words;
+    for (int length : lengths) {
+        if (!loadWords(dictionaryPath(options.wordsDir, length), words)) continue;
+        // As scripts/pack-dictionaries.js: entries of another length are dropped
+        words.erase(std::remove_if(words.begin(), words.end(),
+                                   [&](const std::string& word) { return word.length() != static_cast<size_t>(length); }),
+                    words.end());
+        if (words.empty()) continue;
+        if (!options.openingsDir.empty()) {
+            if (!writeOpeningTable(words, options)) return 1;
+        } else {
+            solveDictionary(words, options);
+        }
+        loaded++;
+    }
+    if (loaded == 0) {
+        std::fprintf(stderr, "no dictionaries found in %s\n", options.wordsDir.c_str());
+        return 1;
+    }
+    return 0;
+}
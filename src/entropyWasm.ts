@@ -0,0 +1,309 @@
+// Loader for the C++ entropy engine built by compile-wasm.sh: the SIMD build when the engine
+// supports simd128 (a SIMD module fails to compile without it) and the scalar build otherwise.
+// Both are single-threaded; the parallelism comes from the worker pool, one engine per worker.
+
+export type EntropyModuleVariant = 'wasm-simd' | 'wasm';
+
+export interface WasmEntropyCalculator {
+  setWordLists(allWords: string[], possibleAnswers: string[]): void;
+  setMatrixMode(enabled: boolean): void;
+  // Caps the full matrix, or the row tiles that replace it for dictionaries over the cap
+  setMatrixBudget(bytes: number): void;
+  getTileCacheBytes(): number;
+  setSimdEnabled(enabled: boolean): void;
+  isSimdEnabled(): boolean;
+  calculateEntropy(word: string): number;
+  calculateAllEntropies(): Array<{ word: string; entropy: number; bitsOfInfo: number }>;
+  filterWords(
+    words: string[],
+    knownPositions: string[],
+    yellowLetters: Array<{ letter: string; excludedPositions: number[] }>,
+    grayLetters: string[]
+  ): string[];
+  setConstraints(
+    knownPositions: string[],
+    yellowLetters: Array<{ letter: string; excludedPositions: number[] }>,
+    grayLetters: string[]
+  ): void;
+  // Hard mode ranks only guesses that reuse the hints passed to setConstraints
+  setHardMode(enabled: boolean): void;
+  isHardMode(): boolean;
+  getAllowedGuessCount(): number;
+  filterDictionary(): string[];
+  // Narrows the candidates to the answers matching setConstraints, resolved from posting
+  // bitsets, so the packed lists stay as they are; resetCandidates widens them again
+  applyConstraints(): number;
+  resetCandidates(): void;
+  getCandidateCount(): number;
+  getCandidates(): string[];
+  getCandidateIndices(): number; // candidate answer rows into getResultIndices
+  allocateBuffer(bytes: number): number;
+  freeBuffer(pointer: number): void;
+  setWordListsPacked(
+    guessPointer: number,
+    guessCount: number,
+    answerPointer: number,
+    answerCount: number,
+    wordLength: number
+  ): void;
+  setDictionaryBinary(pointer: number, bytes: number): number;
+  setAnswerPriors(weightsPointer: number, count: number): boolean;
+  clearAnswerPriors(): void;
+  hasAnswerPriors(): boolean;
+  // Engine snapshot for warm starts: serializeState fills getStateBuffer, restoreState loads one
+  serializeState(): number;
+  getStateBuffer(): Uint8Array;
+  releaseStateBuffer(): void;
+  restoreState(pointer: number, bytes: number): boolean;
+  calculateAllEntropiesPacked(): number;
+  beginRankingJob(k: number): void;
+  stepRankingJob(sliceMs: number): number;
+  isRankingJobDone(): boolean;
+  getRankingJobProgress(): number;
+  getRankingJobTotal(): number;
+  cancelRankingJob(): void;
+  getJobCancelPointer(): number;
+  finishRankingJob(): number;
+  buildOpeningTable(openerCount: number, followUps: number): number;
+  getOpeningTable(): Uint8Array;
+  getStats(): EngineStats;
+  resetStats(): void;
+  setCacheBudget(bytes: number): void;
+  clearCache(): void;
+  getCacheHits(): number;
+  getCacheMisses(): number;
+  getCacheBytes(): number;
+  getCacheEntries(): number;
+  setPruningEnabled(enabled: boolean): void;
+  isPruningEnabled(): boolean;
+  getLastScoredGuesses(): number;
+  filterWordsPacked(
+    wordsPointer: number,
+    wordCount: number,
+    wordLength: number,
+    knownPositions: string[],
+    yellowLetters: Array<{ letter: string; excludedPositions: number[] }>,
+    grayLetters: string[]
+  ): number;
+  getResultIndices(): Uint32Array;
+  getResultEntropies(): Float32Array;
+  getGuessWord(index: number): string;
+  delete(): void;
+}
+
+// Engine counters and per-phase milliseconds since construction or resetStats; all zero with
+// enabled = false in builds compiled with ENTROPY_STATS=0
+export interface EngineStats {
+  enabled: boolean;
+  pairsEvaluated: number;
+  patternsComputed: number;
+  rankings: number;
+  cacheHits: number;
+  cacheMisses: number;
+  tileHits: number;
+  tileMisses: number;
+  tileBytes: number;
+  marshalInMs: number;
+  computeMs: number;
+  sortMs: number;
+  marshalOutMs: number;
+  scratchBytes: number;  // held by the engine's per-call scratch arena
+  scratchBlocks: number; // arena blocks; constant once calls reach steady state
+}
+
+export interface EntropyModuleInstance {
+  EntropyCalculator: new () => WasmEntropyCalculator;
+  HEAPU8: Uint8Array;
+}
+
+export interface LoadedEntropyModule {
+  module: EntropyModuleInstance;
+  variant: EntropyModuleVariant;
+}
+
+const MODULE_SCRIPTS: Record<EntropyModuleVariant, string> = {
+  'wasm-simd': '/entropy-simd.js',
+  'wasm': '/entropy.js',
+};
+
+// Smallest module using a v128 instruction; only validates on engines with simd128
+const SIMD_PROBE = new Uint8Array([
+  0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11,
+]);
+
+export function canUseWasmSimd(): boolean {
+  try {
+    return typeof WebAssembly !== 'undefined' && WebAssembly.validate(SIMD_PROBE);
+  } catch {
+    return false;
+  }
+}
+
+// Loads one specific build; rejects if the file is missing or the engine cannot compile it
+export async function loadEntropyVariant(variant: EntropyModuleVariant): Promise<EntropyModuleInstance> {
+  const { default: factory } = await import(/* webpackIgnore: true */ MODULE_SCRIPTS[variant]);
+  return factory({ locateFile: (path: string) => `/${path}` });
+}
+
+// Packs equal-length words into fixed-stride ASCII rows for the binary entry points
+export function packWords(words: string[], wordLength: number): Uint8Array {
+  const rows = new Uint8Array(words.length * wordLength);
+  for (let i = 0; i < words.length; i++) {
+    const word = words[i];
+    for (let p = 0; p < wordLength; p++) {
+      rows[i * wordLength + p] = word.charCodeAt(p);
+    }
+  }
+  return rows;
+}
+
+// Copies bytes into a new heap buffer; the caller releases it with freeBuffer.
+// HEAPU8 is read after allocating because the allocation may grow (and replace) the heap.
+export function copyToHeap(
+  module: EntropyModuleInstance,
+  calculator: WasmEntropyCalculator,
+  bytes: Uint8Array
+): number {
+  const pointer = calculator.allocateBuffer(bytes.length);
+  module.HEAPU8.set(bytes, pointer);
+  return pointer;
+}
+
+// setWordLists without per-word embind marshalling. `priors` (one weight per possible answer,
+// e.g. word frequency) switches the engine to prior-weighted entropy for these lists.
+export function setWordListsBinary(
+  module: EntropyModuleInstance,
+  calculator: WasmEntropyCalculator,
+  allWords: string[],
+  possibleAnswers: string[],
+  priors?: Float32Array | null
+): void {
+  const wordLength = allWords.length > 0 ? allWords[0].length : possibleAnswers[0]?.length ?? 0;
+  const guessPointer = copyToHeap(module, calculator, packWords(allWords, wordLength));
+  const answerPointer = copyToHeap(module, calculator, packWords(possibleAnswers, wordLength));
+  try {
+    calculator.setWordListsPacked(guessPointer, allWords.length, answerPointer, possibleAnswers.length, wordLength);
+  } finally {
+    calculator.freeBuffer(guessPointer);
+    calculator.freeBuffer(answerPointer);
+  }
+  if (priors) {
+    setAnswerPriors(module, calculator, priors);
+  }
+}
+
+// Weights the current possible answers by `priors` (parallel to them); false on a length mismatch
+export function setAnswerPriors(
+  module: EntropyModuleInstance,
+  calculator: WasmEntropyCalculator,
+  priors: Float32Array
+): boolean {
+  const pointer = copyToHeap(module, calculator, new Uint8Array(priors.buffer, priors.byteOffset, priors.byteLength));
+  try {
+    return calculator.setAnswerPriors(pointer, priors.length);
+  } finally {
+    calculator.freeBuffer(pointer);
+  }
+}
+
+// Loads a words_N_letters.bin buffer as both word lists; returns the word count or -1
+export function setDictionaryBinary(
+  module: EntropyModuleInstance,
+  calculator: WasmEntropyCalculator,
+  dictionary: ArrayBuffer
+): number {
+  const pointer = copyToHeap(module, calculator, new Uint8Array(dictionary));
+  try {
+    return calculator.setDictionaryBinary(pointer, dictionary.byteLength);
+  } finally {
+    calculator.freeBuffer(pointer);
+  }
+}
+
+// Snapshot of the installed lists and precomputed tables, copied out of WASM memory; null while streaming
+export function serializeEngineState(calculator: WasmEntropyCalculator): Uint8Array | null {
+  if (calculator.serializeState() <= 0) return null;
+  const state = calculator.getStateBuffer().slice();
+  calculator.releaseStateBuffer();
+  return state;
+}
+
+// Loads a serializeEngineState snapshot in place of setWordLists*; false when it is rejected
+export function restoreEngineState(
+  module: EntropyModuleInstance,
+  calculator: WasmEntropyCalculator,
+  state: Uint8Array
+): boolean {
+  const pointer = copyToHeap(module, calculator, state);
+  try {
+    return calculator.restoreState(pointer, state.byteLength);
+  } finally {
+    calculator.freeBuffer(pointer);
+  }
+}
+
+// Copies the ranked results out of WASM memory so they survive later heap growth
+export function readRankedResults(calculator: WasmEntropyCalculator): {
+  indices: Uint32Array;
+  entropies: Float32Array;
+} {
+  return {
+    indices: calculator.getResultIndices().slice(),
+    entropies: calculator.getResultEntropies().slice(),
+  };
+}
+
+export interface RankedWord {
+  word: string;
+  entropy: number;
+}
+
+// Words for the last ranking; indices are copied first since getGuessWord may grow the heap
+export function rankedWords(calculator: WasmEntropyCalculator): RankedWord[] {
+  const { indices, entropies } = readRankedResults(calculator);
+  const results: RankedWord[] = [];
+  for (let i = 0; i < indices.length; i++) {
+    results.push({ word: calculator.getGuessWord(indices[i]), entropy: entropies[i] });
+  }
+  return results;
+}
+
+export interface RankingProgress {
+  scored: number;
+  total: number;
+}
+
+// Yields to the event loop so queued messages (a cancel, a newer request) run between slices
+export function yieldToEventLoop(): Promise<void> {
+  return new Promise(resolve => {
+    const channel = new MessageChannel();
+    channel.port1.onmessage = () => {
+      channel.port1.close();
+      resolve();
+    };
+    channel.port2.postMessage(null);
+  });
+}
+
+// Ranks the k best guesses (k <= 0 for all) in `sliceMs` slices, reporting progress after each
+// slice. Resolves null when `shouldStop` turns true or the candidates change mid-job.
+// The calculator holds one job: callers sharing it must await one ranking before starting the next
+export async function rankInSlices(
+  calculator: WasmEntropyCalculator,
+  k: number,
+  onProgress?: (progress: RankingProgress) => void,
+  shouldStop: () => boolean = () => false,
+  sliceMs = 8
+): Promise<RankedWord[] | null> {
+  calculator.beginRankingJob(k);
+  const total = calculator.getRankingJobTotal();
+  while (!calculator.isRankingJobDone()) {
+    if (shouldStop()) calculator.cancelRankingJob();
+    const scored = calculator.stepRankingJob(sliceMs);
+    if (scored < 0) return null;
+    onProgress?.({ scored, total });
+    await yieldToEventLoop();
+  }
+  if (shouldStop() || calculator.finishRankingJob() < 0) return null;
+  return rankedWords(calculator);
+}
@@ -1,79 +1,154 @@
 // Web Worker Interface for High-Performance Entropy Calculations
-// Provides async communication with the optimized entropy worker
+// Provides async communication with a pool of entropy workers. Every worker holds the same
+// dictionary (sent once per word list, shared when the page is cross-origin isolated) and
+// scores its own shard of the guesses; the manager merges the per-shard top-K results.
+// Workers are spawned on first use, so importing the manager costs nothing at startup, and
+// readiness listeners follow the pool from idle through engine loading to ready.
+
+import type { EngineStats } from './entropyWasm';
+import type { WordConstraints } from './wordFilter';
+
+// More workers than this split the guess list too finely to pay for their startup
+const MAX_POOL_SIZE = 4;
+
+interface PendingRequest {
+  resolve: (value: any) => void;
+  reject: (error: Error) => void;
+  onProgress?: (progress: EntropyProgress) => void;
+}
 
 export class EntropyWorkerManager {
-  private worker: Worker | null = null;
+  private workers: Worker[] = [];
   private requestCounter = 0;
-  private pendingRequests = new Map<string, {
-    resolve: (value: any) => void;
-    reject: (error: Error) => void;
-  }>();
+  private pendingRequests = new Map<string, PendingRequest>();
+
+  // The dictionary the workers hold, and each word's index for shipping answers as indices
+  private dictionary: string[] | null = null;
+  private dictionaryIndex = new Map<string, number>();
+  private dictionaryReady: Promise<unknown> = Promise.resolve();
+  private defaultAnswers: string[] = [];
+
+  // Engine each worker benchmarked as fastest on its first dictionary
+  private backendReport: EntropyBackendReport | null = null;
+
+  // The latest bulk calculation; a newer one aborts it before or during its run
+  private latestCalculation: AbortController | null = null;
+
+  private poolSize: number; // workers spawned on first use; 0 once terminated
+  private readiness: EntropyReadiness = { stage: 'idle', words: 0, backend: null };
+  private readinessListeners = new Set<(readiness: EntropyReadiness) => void>();
+
+  constructor(poolSize = defaultPoolSize()) {
+    this.poolSize = poolSize;
+  }
+
+  private ensureWorkers(): Worker[] {
+    if (this.workers.length === 0 && this.poolSize > 0) {
+      this.initializeWorkers(this.poolSize);
+    }
+    return this.workers;
+  }
 
-  constructor() {
-    this.initializeWorker();
+  private setReadiness(readiness: EntropyReadiness) {
+    this.readiness = readiness;
+    this.readinessListeners.forEach(listener => listener(readiness));
   }
 
-  private initializeWorker() {
+  private createWorker(): Worker {
+    // Try to load the TypeScript worker first, fallback to JS worker
     try {
-      // Try to load the TypeScript worker first, fallback to JS worker
-      try {
-        this.worker = new Worker(new URL('./entropyWorker.worker.ts', import.meta.url), {
-          type: 'module'
-        });
-      } catch {
-        // Fallback to JavaScript worker
-        this.worker = new Worker('/entropyWorker.js');
+      return new Worker(new URL('./entropyWorker.worker.ts', import.meta.url), {
+        type: 'module'
+      });
+    } catch {
+      // Fallback to JavaScript worker
+      return new Worker('/entropyWorker.js');
+    }
+  }
+
+  private initializeWorkers(poolSize: number) {
+    try {
+      for (let i = 0; i < poolSize; i++) {
+        const worker = this.createWorker();
+        worker.onmessage = (e) => this.handleMessage(e);
+        worker.onerror = (error) => {
+          console.error('❌ Worker error:', error);
+          // Reject all pending requests
+          this.pendingRequests.forEach((request) => {
+            request.reject(new Error('Worker error occurred'));
+          });
+          this.pendingRequests.clear();
+        };
+        this.workers.push(worker);
       }
-      
-      this.worker.onmessage = (e) => {
-        const { type, requestId, result, error } = e.data;
-        
-        const request = this.pendingRequests.get(requestId);
-        if (!request) {
-          console.warn('⚠️ Received response for unknown request:', requestId);
-          return;
-        }
-        
-        this.pendingRequests.delete(requestId);
-        
-        if (type === 'success') {
-          request.resolve(result);
-        } else if (type === 'error') {
-          request.reject(new Error(error));
-        }
-      };
-      
-      this.worker.onerror = (error) => {
-        console.error('❌ Worker error:', error);
-        // Reject all pending requests
-        this.pendingRequests.forEach((request) => {
-          request.reject(new Error('Worker error occurred'));
-        });
-        this.pendingRequests.clear();
-      };
-      
-      console.log('🚀 Entropy Worker initialized successfully');
+
+      console.log(`🚀 Entropy Worker pool initialized with ${this.workers.length} workers`);
     } catch (error) {
       console.error('❌ Failed to initialize worker:', error);
     }
   }
 
-  private sendMessage(type: string, data: any): Promise<any> {
-    if (!this.worker) {
+  private handleMessage(e: MessageEvent) {
+    const { type, requestId, result, error, progress } = e.data;
+
+    const request = this.pendingRequests.get(requestId);
+    if (!request) {
+      // Late messages for requests the caller already abandoned
+      if (type !== 'progress' && type !== 'cancelled') {
+        console.warn('⚠️ Received response for unknown request:', requestId);
+      }
+      return;
+    }
+
+    if (type === 'progress') {
+      request.onProgress?.(progress);
+      return;
+    }
+
+    this.pendingRequests.delete(requestId);
+
+    if (type === 'success') {
+      request.resolve(result);
+    } else if (type === 'error') {
+      request.reject(new Error(error));
+    } else if (type === 'cancelled') {
+      request.reject(abortError());
+    }
+  }
+
+  private sendMessage(
+    worker: Worker | undefined,
+    type: string,
+    data: any,
+    options: EntropyRequestOptions = {},
+    transfer: Transferable[] = []
+  ): Promise<any> {
+    if (!worker) {
       return Promise.reject(new Error('Worker not initialized'));
     }
+    if (options.signal?.aborted) {
+      return Promise.reject(abortError());
+    }
 
     const requestId = `req_${++this.requestCounter}`;
-    
+
     return new Promise((resolve, reject) => {
-      this.pendingRequests.set(requestId, { resolve, reject });
-      
-      this.worker!.postMessage({
+      this.pendingRequests.set(requestId, { resolve, reject, onProgress: options.onProgress });
+
+      // Abandon the request at once; the worker drops the job at its next slice boundary
+      options.signal?.addEventListener('abort', () => {
+        if (this.pendingRequests.delete(requestId)) {
+          worker.postMessage({ type: 'cancel', data: { requestId } });
+          reject(abortError());
+        }
+      }, { once: true });
+
+      worker.postMessage({
         type,
         data,
         requestId
-      });
-      
+      }, transfer);
+
       // Add timeout to prevent hanging requests
       setTimeout(() => {
         if (this.pendingRequests.has(requestId)) {
@@ -84,35 +159,182 @@ export class EntropyWorkerManager {
     });
   }
 
+  // Sends the dictionary to every worker unless they already hold this word list
+  private ensureDictionary(allWords: string[]): Promise<unknown> {
+    if (allWords === this.dictionary) {
+      return this.dictionaryReady;
+    }
+
+    this.ensureWorkers();
+    this.dictionary = allWords;
+    this.dictionaryIndex = new Map();
+    for (let i = 0; i < allWords.length; i++) {
+      this.dictionaryIndex.set(allWords[i], i);
+    }
+
+    const { bytes, stride } = encodeWords(allWords, canShareMemory());
+    const shardSize = Math.ceil(allWords.length / Math.max(1, this.workers.length));
+    console.log(`📤 Sending ${allWords.length}-word dictionary to ${this.workers.length} workers`);
+    this.setReadiness({ stage: 'loading', words: allWords.length, backend: this.backendReport });
+
+    this.dictionaryReady = Promise.all(this.workers.map((worker, i) => {
+      // A shared buffer is posted as is; otherwise each worker gets its own transferred copy
+      const shardBytes = bytes.buffer instanceof ArrayBuffer ? bytes.slice() : bytes;
+      const transfer = shardBytes.buffer instanceof ArrayBuffer ? [shardBytes.buffer] : [];
+      return this.sendMessage(worker, 'setDictionary', {
+        bytes: shardBytes,
+        stride,
+        count: allWords.length,
+        shardBegin: Math.min(allWords.length, i * shardSize),
+        shardEnd: Math.min(allWords.length, (i + 1) * shardSize)
+      }, {}, transfer);
+    })).then(results => {
+      // The plain JS fallback worker has no benchmark and always runs JS
+      const report = results[0]?.backend ? results[0] as EntropyBackendReport : { backend: 'js', timings: {} };
+      if (!this.backendReport) console.log(`⚡ Entropy pool running on ${report.backend}`, report.timings);
+      this.backendReport = report;
+      // A newer word list may have been sent meanwhile; it reports its own readiness
+      if (this.dictionary === allWords) this.setReadiness({ stage: 'ready', words: allWords.length, backend: report });
+    }, error => {
+      if (this.dictionary === allWords) this.setReadiness({ stage: 'idle', words: 0, backend: this.backendReport });
+      throw error;
+    });
+    return this.dictionaryReady;
+  }
+
+  // Answers as dictionary indices when they all come from it, which is the usual case
+  private encodeAnswers(possibleAnswers: string[]): { answerIndices?: Uint32Array; answers?: string[] } {
+    const answerIndices = new Uint32Array(possibleAnswers.length);
+    for (let i = 0; i < possibleAnswers.length; i++) {
+      const index = this.dictionaryIndex.get(possibleAnswers[i]);
+      if (index === undefined) return { answers: possibleAnswers };
+      answerIndices[i] = index;
+    }
+    return { answerIndices };
+  }
+
   // Set word lists for calculations
   async setWordLists(allWords: string[], possibleAnswers: string[]): Promise<void> {
-    console.log(`📤 Sending word lists to worker: ${allWords.length} total, ${possibleAnswers.length} possible`);
-    return this.sendMessage('setWordLists', { allWords, possibleAnswers });
+    this.defaultAnswers = possibleAnswers;
+    await this.ensureDictionary(allWords);
   }
 
-  // Calculate entropy for a single word
+  // Prior weight per word of `allWords` (e.g. word frequency, Float32Array parallel to it) so
+  // rankings use answer-weighted entropy; null goes back to uniform answers. The priors stay
+  // with this dictionary and are dropped when a different word list is sent.
+  async setWordPriors(allWords: string[], priors: Float32Array | null): Promise<void> {
+    if (priors && priors.length !== allWords.length) {
+      throw new Error(`Expected ${allWords.length} priors, got ${priors.length}`);
+    }
+    const shared = priors && canShareMemory() ? shareFloats(priors) : null;
+    this.dictionaryReady = this.ensureDictionary(allWords).then(() => Promise.all(this.workers.map(worker => {
+      // Shared priors are posted as is; otherwise each worker gets its own transferred copy
+      const copy = shared ?? priors?.slice() ?? null;
+      const transfer = copy && copy.buffer instanceof ArrayBuffer ? [copy.buffer] : [];
+      return this.sendMessage(worker, 'setPriors', { priors: copy }, {}, transfer);
+    })));
+    await this.dictionaryReady;
+  }
+
+  // Calculate entropy for a single word against `possibleAnswers` (default: the dictionary),
+  // on the worker's engine; answers from the dictionary travel as indices
   async calculateEntropy(word: string, possibleAnswers?: string[]): Promise<number> {
-    return this.sendMessage('calculateEntropy', { word, possibleAnswers });
+    const worker = this.ensureWorkers()[0];
+    await this.dictionaryReady;
+    const answers = possibleAnswers ? this.encodeAnswers(possibleAnswers) : {};
+    return this.sendMessage(worker, 'calculateEntropy', {
+      word,
+      answerIndices: answers.answerIndices,
+      possibleAnswers: answers.answers
+    });
   }
 
   // Calculate entropy for all words (high-performance bulk operation)
-  async calculateAllEntropies(allWords?: string[], possibleAnswers?: string[]): Promise<Array<{
-    word: string;
-    entropy: number;
-    bitsOfInfo: number;
-  }>> {
-    console.log('🧮 Starting bulk entropy calculation in worker...');
-    return this.sendMessage('calculateAllEntropies', { allWords, possibleAnswers });
+  // Each worker scores its shard in short slices: `onProgress` gets words scored / total across
+  // the pool, and aborting `signal` abandons the job. Calls made in quick succession coalesce:
+  // a newer call aborts the older one, so only the latest constraint state is computed.
+  // `topK` > 0 returns only the best topK words (merged from each shard's own top K).
+  // With `constraints` the answers are the dictionary words the board allows, narrowed inside
+  // each worker's engine instead of shipped (possibleAnswers is then ignored), and `hardMode`
+  // limits the guesses to those reusing the board's hints.
+  async calculateAllEntropies(
+    allWords?: string[],
+    possibleAnswers?: string[],
+    options: EntropyRequestOptions & { topK?: number; constraints?: WordConstraints; hardMode?: boolean } = {}
+  ): Promise<EntropyResult[]> {
+    if (this.ensureWorkers().length === 0) {
+      throw new Error('Worker not initialized');
+    }
+    this.latestCalculation?.abort();
+    const controller = new AbortController();
+    this.latestCalculation = controller;
+    options.signal?.addEventListener('abort', () => controller.abort(), { once: true });
+    if (options.signal?.aborted) controller.abort();
+
+    if (allWords) {
+      this.ensureDictionary(allWords);
+    }
+    const board = options.constraints
+      ? { constraints: options.constraints, hardMode: options.hardMode ?? false }
+      : null;
+    const answers = board ? {} : this.encodeAnswers(possibleAnswers ?? this.defaultAnswers);
+    await this.dictionaryReady;
+
+    // Let calls made in the same burst supersede this one before any worker starts on it
+    await new Promise(resolve => setTimeout(resolve, 0));
+    if (controller.signal.aborted) {
+      throw abortError();
+    }
+
+    console.log('🧮 Starting bulk entropy calculation in worker pool...');
+    const topK = options.topK ?? 0;
+    const total = this.dictionary?.length ?? 0;
+    const scoredPerShard = new Array(this.workers.length).fill(0);
+    // Hard mode shrinks each shard to its allowed guesses, which the shards report
+    const totalPerShard = new Array(this.workers.length).fill(total / this.workers.length);
+    const sum = (values: number[]) => values.reduce((a, b) => a + b, 0);
+
+    const shards = await Promise.all(this.workers.map((worker, i) => {
+      const answerIndices = answers.answerIndices?.slice();
+      return this.sendMessage(worker, 'calculateShard', {
+        answerIndices,
+        answers: answers.answers,
+        topK,
+        ...board
+      }, {
+        signal: controller.signal,
+        onProgress: (progress) => {
+          scoredPerShard[i] = progress.scored;
+          totalPerShard[i] = progress.total;
+          options.onProgress?.({ scored: sum(scoredPerShard), total: Math.round(sum(totalPerShard)) });
+        }
+      }, answerIndices ? [answerIndices.buffer] : []);
+    }));
+
+    if (this.latestCalculation === controller) this.latestCalculation = null;
+    return mergeRankedShards(shards, topK);
   }
 
-  // Filter words based on constraints
+  // Filter words based on constraints, on the worker's engine (JS when no WASM build loaded).
+  // The dictionary the pool holds is filtered in place and comes back as row indices.
   async filterWords(
     words: string[],
     knownPositions: string[],
     yellowLetters: Array<{ letter: string; excludedPositions: number[] }>,
     grayLetters: string[]
   ): Promise<string[]> {
-    return this.sendMessage('filterWords', {
+    const worker = this.ensureWorkers()[0];
+    if (words === this.dictionary) {
+      await this.dictionaryReady;
+      // A newer word list may have replaced this one meanwhile
+      if (words === this.dictionary) {
+        const rows: Uint32Array = await this.sendMessage(worker, 'filterDictionary', {
+          constraints: { knownPositions, yellowLetters, grayLetters }
+        });
+        return Array.from(rows, row => words[row]);
+      }
+    }
+    return this.sendMessage(worker, 'filterWords', {
       words,
       knownPositions,
       yellowLetters,
@@ -120,20 +342,108 @@ export class EntropyWorkerManager {
     });
   }
 
-  // Terminate the worker
+  // Terminate the worker pool; later calls fail instead of spawning a new one
   terminate() {
-    if (this.worker) {
-      this.worker.terminate();
-      this.worker = null;
+    this.poolSize = 0;
+    if (this.workers.length > 0) {
+      this.workers.forEach(worker => worker.terminate());
+      this.workers = [];
       this.pendingRequests.clear();
-      console.log('🛑 Entropy Worker terminated');
+      this.dictionary = null;
+      console.log('🛑 Entropy Worker pool terminated');
     }
+    this.setReadiness({ stage: 'idle', words: 0, backend: null });
+  }
+
+  // Per-worker engine counters and phase timings (see EngineStats in entropyWasm.ts);
+  // null for workers running the JS backend
+  async getEngineStats(): Promise<Array<EngineStats | null>> {
+    return Promise.all(this.workers.map(worker => this.sendMessage(worker, 'getStats', {})));
+  }
+
+  // Engine chosen by the workers' startup benchmark; null until the first dictionary is loaded
+  getBackend(): EntropyBackendReport | null {
+    return this.backendReport;
   }
 
-  // Check if worker is ready
+  // True once the pool holds a dictionary and can rank it
   isReady(): boolean {
-    return this.worker !== null;
+    return this.readiness.stage === 'ready';
   }
+
+  getReadiness(): EntropyReadiness {
+    return this.readiness;
+  }
+
+  // Calls `listener` now and on every readiness change; returns the unsubscribe function
+  onReadiness(listener: (readiness: EntropyReadiness) => void): () => void {
+    this.readinessListeners.add(listener);
+    listener(this.readiness);
+    return () => {
+      this.readinessListeners.delete(listener);
+    };
+  }
+}
+
+function defaultPoolSize(): number {
+  if (typeof Worker === 'undefined') return 0;
+  const cores = typeof navigator !== 'undefined' ? navigator.hardwareConcurrency || 2 : 2;
+  // Leave a core for the main thread
+  return Math.max(1, Math.min(MAX_POOL_SIZE, cores - 1));
+}
+
+// One buffer can be posted to every worker only when SharedArrayBuffer is usable
+function canShareMemory(): boolean {
+  return typeof SharedArrayBuffer !== 'undefined' && typeof crossOriginIsolated !== 'undefined' && crossOriginIsolated;
+}
+
+// Words as fixed-stride char codes, zero padded to the longest word
+function encodeWords(words: string[], shared: boolean): { bytes: Uint8Array; stride: number } {
+  let stride = 0;
+  for (let i = 0; i < words.length; i++) {
+    stride = Math.max(stride, words[i].length);
+  }
+  const byteLength = words.length * stride;
+  const bytes = shared ? new Uint8Array(new SharedArrayBuffer(byteLength)) : new Uint8Array(byteLength);
+  for (let i = 0; i < words.length; i++) {
+    const word = words[i];
+    for (let j = 0; j < word.length; j++) {
+      bytes[i * stride + j] = word.charCodeAt(j);
+    }
+  }
+  return { bytes, stride };
+}
+
+function shareFloats(values: Float32Array): Float32Array {
+  const shared = new Float32Array(new SharedArrayBuffer(values.byteLength));
+  shared.set(values);
+  return shared;
+}
+
+// k-way merge of per-shard rankings (each sorted by entropy, best first)
+function mergeRankedShards(shards: EntropyResult[][], topK: number): EntropyResult[] {
+  const total = shards.reduce((count, shard) => count + shard.length, 0);
+  const limit = topK > 0 ? Math.min(topK, total) : total;
+  const heads = new Array(shards.length).fill(0);
+  const merged: EntropyResult[] = [];
+
+  while (merged.length < limit) {
+    let best = -1;
+    for (let s = 0; s < shards.length; s++) {
+      if (heads[s] < shards[s].length &&
+          (best < 0 || shards[s][heads[s]].entropy > shards[best][heads[best]].entropy)) {
+        best = s;
+      }
+    }
+    merged.push(shards[best][heads[best]++]);
+  }
+  return merged;
+}
+
+function abortError(): Error {
+  const error = new Error('Entropy calculation cancelled');
+  error.name = 'AbortError';
+  return error;
 }
 
 // Singleton instance for global use
@@ -146,8 +456,28 @@ export interface EntropyResult {
   bitsOfInfo: number;
 }
 
-export interface WordConstraints {
-  knownPositions: string[];
-  yellowLetters: Array<{ letter: string; excludedPositions: number[] }>;
-  grayLetters: string[];
-}
\ No newline at end of file
+export interface EntropyProgress {
+  scored: number;
+  total: number;
+}
+
+export interface EntropyBackendReport {
+  backend: 'wasm-simd' | 'wasm' | 'js';
+  timings: Partial<Record<'wasm-simd' | 'wasm' | 'js', number>>; // benchmark milliseconds
+}
+
+// Pool startup stages: 'idle' until a word list is sent (workers are spawned then), 'loading'
+// while the workers load their engine and install the dictionary, 'ready' once every one has
+export interface EntropyReadiness {
+  stage: 'idle' | 'loading' | 'ready';
+  words: number; // the dictionary being loaded or held
+  backend: EntropyBackendReport | null;
+}
+
+export interface EntropyRequestOptions {
+  onProgress?: (progress: EntropyProgress) => void;
+  signal?: AbortSignal;
+}
+
+// Board constraints are defined with the JS filter; re-exported for callers of the manager
+export type { WordConstraints } from './wordFilter';
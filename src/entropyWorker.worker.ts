@@ -1,8 +1,29 @@
 // High-Performance Entropy Calculation Web Worker
 // TypeScript Web Worker with proper typing
+// Rankings run on the C++ engine when a WASM build loads; a startup micro-benchmark on the
+// first dictionary picks WASM-SIMD, WASM-scalar or the JS calculator below for this device.
+// The pick and the engine's state for each dictionary shard (packed lists and priors) are
+// cached for the next visit.
 
 /// <reference lib="webworker" />
 
+import {
+  EngineStats,
+  EntropyModuleVariant,
+  LoadedEntropyModule,
+  RankingProgress,
+  WasmEntropyCalculator,
+  canUseWasmSimd,
+  loadEntropyVariant,
+  rankInSlices,
+  restoreEngineState,
+  serializeEngineState,
+  setWordListsBinary,
+  yieldToEventLoop,
+} from './entropyWasm';
+import { hashStateBytes, readEngineState, writeEngineState } from './engineStateCache';
+import { WordConstraints, compileConstraints, filterWords, matchesConstraints, satisfiesHints } from './wordFilter';
+
 declare const self: DedicatedWorkerGlobalScope;
 
 interface WorkerMessage {
@@ -12,15 +33,27 @@ interface WorkerMessage {
 }
 
 interface WorkerResponse {
-  type: 'success' | 'error';
+  type: 'success' | 'error' | 'progress' | 'cancelled';
   requestId: string;
   result?: any;
   error?: string;
+  progress?: RankingProgress;
+}
+
+interface EntropyResult {
+  word: string;
+  entropy: number;
+  bitsOfInfo: number;
 }
 
+// Scoring slice length; short enough that a cancel or newer request waits under a frame
+const SLICE_MS = 8;
+
 class OptimizedEntropyCalculator {
   private allWords: string[] = [];
   private possibleAnswers: string[] = [];
+  private shardWords: string[] = []; // guesses this worker scores in the pool protocol
+  private priors: Float32Array | null = null; // per dictionary word, from setPriors
 
   constructor() {
     console.log('🧠 High-Performance Entropy Calculator initialized');
@@ -58,22 +91,25 @@ class OptimizedEntropyCalculator {
     return result.join('');
   }
 
-  // Optimized entropy calculation with Map for O(1) lookups
-  calculateEntropy(guessWord: string, possibleAnswers = this.possibleAnswers): number {
+  // Optimized entropy calculation with Map for O(1) lookups; `weights` (parallel to the
+  // answers) gives the prior-weighted entropy
+  calculateEntropy(guessWord: string, possibleAnswers = this.possibleAnswers, weights: Float32Array | null = null): number {
     if (possibleAnswers.length <= 1) return 0;
     
     const patternCounts = new Map<string, number>();
     const upperGuess = guessWord.toUpperCase();
+    let totalAnswers = 0;
     
     // Use for-loop instead of forEach for better performance
     for (let i = 0; i < possibleAnswers.length; i++) {
       const pattern = this.getPattern(upperGuess, possibleAnswers[i]);
-      patternCounts.set(pattern, (patternCounts.get(pattern) || 0) + 1);
+      const weight = weights ? weights[i] : 1;
+      patternCounts.set(pattern, (patternCounts.get(pattern) || 0) + weight);
+      totalAnswers += weight;
     }
     
     // Calculate Shannon entropy with optimized math
     let entropy = 0;
-    const totalAnswers = possibleAnswers.length;
     const log2 = Math.log(2);
     
     // Use forEach instead of for...of for compatibility
@@ -114,66 +150,38 @@ class OptimizedEntropyCalculator {
     return results;
   }
 
-  // High-speed word filtering with early termination
-  filterWords(
-    words: string[], 
-    knownPositions: string[], 
-    yellowLetters: Array<{ letter: string; excludedPositions: number[] }>, 
-    grayLetters: string[]
-  ): string[] {
-    const filtered: string[] = [];
-    const graySet = new Set(grayLetters.map(l => l.toUpperCase()));
-    
-    // Pre-process yellow letters for faster lookup
-    const yellowConstraints = yellowLetters.map(y => ({
-      letter: y.letter.toUpperCase(),
-      excludedSet: new Set(y.excludedPositions)
-    }));
-    
-    wordLoop: for (let i = 0; i < words.length; i++) {
-      const word = words[i].toUpperCase();
-      
-      // Check gray letters first (fastest elimination)
-      for (let j = 0; j < word.length; j++) {
-        if (graySet.has(word[j])) {
-          continue wordLoop;
-        }
-      }
-      
-      // Check known positions (green letters)
-      for (let j = 0; j < knownPositions.length; j++) {
-        if (knownPositions[j] && word[j] !== knownPositions[j]) {
-          continue wordLoop;
-        }
-      }
-      
-      // Check yellow letters
-      let skipWord = false;
-      for (const yellow of yellowConstraints) {
-        // Word must contain the letter
-        if (!word.includes(yellow.letter)) {
-          skipWord = true;
-          break;
-        }
-        
-        // Letter must not be in excluded positions
-        const excludedPositions = Array.from(yellow.excludedSet);
-        for (let k = 0; k < excludedPositions.length; k++) {
-          if (word[excludedPositions[k]] === yellow.letter) {
-            skipWord = true;
-            break;
-          }
-        }
-        
-        if (skipWord) break;
-      }
-      
-      if (skipWord) continue;
-      
-      filtered.push(words[i]); // Keep original case
+  // calculateAllEntropies in SLICE_MS slices, reporting progress after each slice and
+  // checking `isCancelled` between slices; resolves null when cancelled
+  async calculateAllEntropiesSliced(
+    allWords = this.allWords,
+    possibleAnswers = this.possibleAnswers,
+    onProgress: (progress: RankingProgress) => void,
+    isCancelled: () => boolean,
+    weights: Float32Array | null = null
+  ) {
+    if (possibleAnswers.length === 0) return [];
+
+    const results = new Array(allWords.length);
+    let scored = 0;
+    while (scored < allWords.length) {
+      const sliceEnd = performance.now() + SLICE_MS;
+      do {
+        const entropy = this.calculateEntropy(allWords[scored], possibleAnswers, weights);
+        results[scored] = {
+          word: allWords[scored],
+          entropy: entropy,
+          bitsOfInfo: Math.round(entropy * 100) / 100
+        };
+        scored++;
+      } while (scored < allWords.length && performance.now() < sliceEnd);
+
+      onProgress({ scored, total: allWords.length });
+      await yieldToEventLoop();
+      if (isCancelled()) return null;
     }
-    
-    return filtered;
+
+    results.sort((a, b) => b.entropy - a.entropy);
+    return results;
   }
 
   // Set word lists for calculations
@@ -182,14 +190,415 @@ class OptimizedEntropyCalculator {
     this.possibleAnswers = possibleAnswers.map(w => w.toUpperCase());
     console.log(`📝 Word lists updated: ${this.allWords.length} total, ${this.possibleAnswers.length} possible`);
   }
+
+  // Pool protocol: the whole dictionary (fixed-stride char codes, zero padded) plus the range
+  // of guesses this worker scores. Answers arrive later as indices into the dictionary.
+  setDictionary(bytes: Uint8Array, stride: number, count: number, shardBegin: number, shardEnd: number): void {
+    const words = new Array<string>(count);
+    for (let i = 0; i < count; i++) {
+      let word = '';
+      for (let j = 0; j < stride && bytes[i * stride + j] !== 0; j++) {
+        word += String.fromCharCode(bytes[i * stride + j]);
+      }
+      words[i] = word.toUpperCase();
+    }
+    this.allWords = words;
+    this.possibleAnswers = words;
+    this.shardWords = words.slice(shardBegin, shardEnd);
+    this.priors = null;
+    console.log(`📝 Dictionary received: ${count} words, scoring ${shardBegin}-${shardEnd}`);
+  }
+
+  // Answer priors for the current dictionary (a shared or transferred Float32Array), or null
+  setPriors(priors: Float32Array | null): void {
+    this.priors = priors && priors.length === this.allWords.length ? priors : null;
+  }
+
+  // Weights parallel to the resolved answers; null when uniform or the answers came as words
+  resolvePriors(answerIndices: Uint32Array | undefined, answers?: string[]): Float32Array | null {
+    const priors = this.priors;
+    if (!priors || (!answerIndices && answers)) return null;
+    return answerIndices ? Float32Array.from(answerIndices, i => priors[i]) : priors;
+  }
+
+  getDictionary(): string[] {
+    return this.allWords;
+  }
+
+  getShardWords(): string[] {
+    return this.shardWords;
+  }
+
+  // Answers of a request: dictionary indices, words when they are not all in it, or else the
+  // dictionary itself (the list the engine already holds)
+  resolveAnswers(answerIndices: Uint32Array | undefined, answers: string[] | undefined): string[] {
+    if (answerIndices) return Array.from(answerIndices, i => this.allWords[i]);
+    return answers ? answers.map(w => w.toUpperCase()) : this.possibleAnswers;
+  }
 }
 
 // Global calculator instance
 const calculator = new OptimizedEntropyCalculator();
 
+type BackendName = EntropyModuleVariant | 'js';
+
+// The game state a ranking is for: the answers its constraints allow, and in hard mode only
+// the guesses that reuse its hints
+interface Board {
+  constraints: WordConstraints;
+  hardMode: boolean;
+}
+
+// Ranks `guesses` against `answers` (weighted by `priors` when given, narrowed by `board`) in
+// slices, the best topK when topK > 0; null when cancelled
+interface RankingBackend {
+  name: BackendName;
+  rank(
+    guesses: string[],
+    answers: string[],
+    priors: Float32Array | null,
+    topK: number,
+    onProgress: (progress: RankingProgress) => void,
+    isCancelled: () => boolean,
+    board?: Board | null
+  ): Promise<EntropyResult[] | null>;
+  // Entropy of one guess against `answers`
+  entropy(guess: string, answers: string[], priors: Float32Array | null): Promise<number>;
+  // Words of any list consistent with the board
+  filter(words: string[], constraints: WordConstraints): Promise<string[]>;
+  // Rows of `answers` consistent with the board; the WASM backends resolve them from the
+  // engine's posting bitsets over the lists it already holds
+  filterAnswers(guesses: string[], answers: string[], priors: Float32Array | null,
+                constraints: WordConstraints): Promise<Uint32Array>;
+  stats?(): EngineStats; // engine counters; only the WASM backends have them
+  // Engine state for warm starts: the packed lists and priors it holds (plus a pattern matrix
+  // or opening table if the engine had one, which pool workers never build); WASM backends only
+  snapshot?(guesses: string[], answers: string[], priors: Float32Array | null): Promise<Uint8Array | null>;
+  restore?(state: Uint8Array, guesses: string[], answers: string[], priors: Float32Array | null): Promise<boolean>;
+}
+
+interface BackendReport {
+  backend: BackendName;
+  timings: Partial<Record<BackendName, number>>; // benchmark milliseconds per candidate
+}
+
+// JS filterAnswers, also used by the engine when the board is for another word length
+function matchingRows(answers: string[], constraints: WordConstraints): Uint32Array {
+  const compiled = compileConstraints(answers[0]?.length ?? 0, constraints);
+  const rows: number[] = [];
+  answers.forEach((answer, row) => {
+    if (matchesConstraints(answer, compiled)) rows.push(row);
+  });
+  return Uint32Array.from(rows);
+}
+
+const jsBackend: RankingBackend = {
+  name: 'js',
+  async rank(guesses, answers, priors, topK, onProgress, isCancelled, board) {
+    if (board) {
+      const rows = matchingRows(answers, board.constraints);
+      const compiled = compileConstraints(answers[0]?.length ?? 0, board.constraints);
+      if (board.hardMode) guesses = guesses.filter(guess => satisfiesHints(guess, compiled));
+      answers = Array.from(rows, row => answers[row]);
+      priors = priors && Float32Array.from(rows, row => priors![row]);
+    }
+    const results = await calculator.calculateAllEntropiesSliced(guesses, answers, onProgress, isCancelled, priors);
+    return results && topK > 0 ? results.slice(0, topK) : results;
+  },
+  entropy: async (guess, answers, priors) => calculator.calculateEntropy(guess, answers, priors),
+  filter: async (words, constraints) => filterWords(words, constraints),
+  filterAnswers: async (_guesses, answers, _priors, constraints) => matchingRows(answers, constraints),
+};
+
+// JS until the first dictionary arrives and the benchmark has picked the fastest backend
+let backend: RankingBackend = jsBackend;
+let backendReport: Promise<BackendReport> | null = null;
+
+function sameValues<T>(a: ArrayLike<T> | null, b: ArrayLike<T> | null): boolean {
+  if (a === b) return true;
+  if (!a || !b || a.length !== b.length) return false;
+  for (let i = 0; i < a.length; i++) {
+    if (a[i] !== b[i]) return false;
+  }
+  return true;
+}
+
+function wasmBackend(loaded: LoadedEntropyModule): RankingBackend {
+  const engine: WasmEntropyCalculator = new loaded.module.EntropyCalculator();
+  // Lists the engine holds; a ranking over the same ones skips repacking them
+  let installed: { guesses: string[]; answers: string[]; priors: Float32Array | null } | null = null;
+  const install = (guesses: string[], answers: string[], priors: Float32Array | null) => {
+    if (installed && sameValues(installed.guesses, guesses) && sameValues(installed.answers, answers) &&
+        sameValues(installed.priors, priors)) return;
+    setWordListsBinary(loaded.module, engine, guesses, answers, priors);
+    installed = { guesses, answers, priors };
+  };
+  // The engine holds a single ranking job, so calls on it run one at a time: a superseded
+  // ranking cancels its own job before the next one begins, never the newer job
+  let busy: Promise<unknown> = Promise.resolve();
+  const exclusive = <T>(task: () => T | Promise<T>): Promise<T> => {
+    const run = busy.then(task, task);
+    busy = run.catch(() => {});
+    return run;
+  };
+  return {
+    name: loaded.variant as BackendName,
+    rank: (guesses, answers, priors, topK, onProgress, isCancelled, board) => exclusive(async () => {
+      if (isCancelled()) return null;
+      if (answers.length === 0) return [];
+      install(guesses, answers, priors);
+      engine.resetCandidates();
+      if (board) {
+        // The board narrows the held answers in place, so a changed board repacks nothing
+        const { knownPositions, yellowLetters, grayLetters } = board.constraints;
+        engine.setConstraints(knownPositions, yellowLetters, grayLetters);
+        if (engine.applyConstraints() <= 0) return [];
+      }
+      engine.setHardMode(board?.hardMode ?? false);
+      const ranked = await rankInSlices(engine, topK, onProgress, isCancelled, SLICE_MS);
+      return ranked && ranked.map(({ word, entropy }) => ({
+        word,
+        entropy,
+        bitsOfInfo: Math.round(entropy * 100) / 100
+      }));
+    }),
+    entropy: (guess, answers, priors) => exclusive(() => {
+      // A guess outside the lists scores against the held answers without repacking them
+      install(installed?.guesses ?? [guess], answers, priors);
+      engine.resetCandidates();
+      return engine.calculateEntropy(guess);
+    }),
+    filter: (words, { knownPositions, yellowLetters, grayLetters }) =>
+      exclusive(() => engine.filterWords(words, knownPositions, yellowLetters, grayLetters)),
+    filterAnswers: (guesses, answers, priors, constraints) => exclusive(() => {
+      install(guesses, answers, priors);
+      engine.setConstraints(constraints.knownPositions, constraints.yellowLetters, constraints.grayLetters);
+      engine.resetCandidates();
+      if (engine.applyConstraints() < 0) return matchingRows(answers, constraints);
+      engine.getCandidateIndices();
+      const rows = engine.getResultIndices().slice();
+      engine.resetCandidates();
+      return rows;
+    }),
+    stats: () => engine.getStats(),
+    snapshot: (guesses, answers, priors) => exclusive(() => {
+      install(guesses, answers, priors);
+      return serializeEngineState(engine);
+    }),
+    restore: (state, guesses, answers, priors) => exclusive(() => {
+      // The slot key covers the priors, so a restored state holds exactly these lists and weights
+      installed = restoreEngineState(loaded.module, engine, state) ? { guesses, answers, priors } : null;
+      return installed !== null;
+    }),
+  };
+}
+
+// Benchmark sample size; big enough to amortize call overhead, small enough to finish in ms
+const BENCHMARK_WORDS = 256;
+
+// The scalar and SIMD builds are candidates when they load, and JS always is
+async function candidateBackends(): Promise<RankingBackend[]> {
+  const variants: EntropyModuleVariant[] = canUseWasmSimd() ? ['wasm-simd', 'wasm'] : ['wasm'];
+  const backends: RankingBackend[] = [];
+  for (const variant of variants) {
+    try {
+      backends.push(wasmBackend({ module: await loadEntropyVariant(variant), variant }));
+    } catch (error) {
+      console.warn(`⚠️ ${variant} entropy engine unavailable:`, error);
+    }
+  }
+  backends.push(jsBackend);
+  return backends;
+}
+
+async function timeBackend(candidate: RankingBackend, guesses: string[], answers: string[]): Promise<number> {
+  const never = () => false;
+  const ignore = () => {};
+  await candidate.rank(guesses.slice(0, 16), answers.slice(0, 16), null, 0, ignore, never); // warm-up
+  const start = performance.now();
+  await candidate.rank(guesses, answers, null, 0, ignore, never);
+  return performance.now() - start;
+}
+
+// Times every candidate on a sample of the dictionary and keeps the fastest
+async function selectBackend(words: string[]): Promise<BackendReport> {
+  const step = Math.max(1, Math.floor(words.length / BENCHMARK_WORDS));
+  const sample = words.filter((_, i) => i % step === 0).slice(0, BENCHMARK_WORDS);
+  const timings: BackendReport['timings'] = {};
+  let fastest = jsBackend;
+  for (const candidate of await candidateBackends()) {
+    try {
+      timings[candidate.name] = await timeBackend(candidate, sample, sample);
+      if (timings[candidate.name]! < (timings[fastest.name] ?? Infinity)) fastest = candidate;
+    } catch (error) {
+      console.warn(`⚠️ ${candidate.name} entropy backend failed its benchmark:`, error);
+    }
+  }
+  backend = fastest;
+  console.log(`⚡ Entropy backend: ${fastest.name}`, timings);
+  return { backend: fastest.name, timings };
+}
+
+// Cache slots: the benchmark result for this device, and one engine state per dictionary shard
+const REPORT_SLOT = 'backend-report';
+const reportKey = () => `${navigator.userAgent}|${navigator.hardwareConcurrency}|${canUseWasmSimd()}`;
+
+// Last visit's benchmark result, with its backend loaded; null when there is none to trust
+async function cachedBackend(): Promise<BackendReport | null> {
+  const cached = await readEngineState(REPORT_SLOT, reportKey());
+  if (!cached) return null;
+  try {
+    const report: BackendReport = JSON.parse(new TextDecoder().decode(cached));
+    if (report.backend !== 'js') {
+      backend = wasmBackend({ module: await loadEntropyVariant(report.backend), variant: report.backend });
+    }
+    console.log(`⚡ Entropy backend: ${report.backend} (cached)`, report.timings);
+    return report;
+  } catch (error) {
+    console.warn('⚠️ Cached entropy backend unavailable:', error);
+    return null;
+  }
+}
+
+async function chooseBackend(words: string[]): Promise<BackendReport> {
+  const cached = await cachedBackend();
+  if (cached) return cached;
+  const report = await selectBackend(words);
+  writeEngineState(REPORT_SLOT, reportKey(), new TextEncoder().encode(JSON.stringify(report)));
+  return report;
+}
+
+// Shard and dictionary the engine state cache is keyed by, from the last setDictionary
+let dictionarySlot = '';
+let dictionaryKey = '';
+
+const priorsKey = (priors: Float32Array | null) =>
+  priors ? hashStateBytes(new Uint8Array(priors.buffer, priors.byteOffset, priors.byteLength)) : 'uniform';
+
+// Restores the shard's engine state (packed lists and priors) from the last visit, or caches
+// it for the next one. Uniform and weighted states keep separate slots: a visit that sets
+// priors installs one after the other, and a shared slot would overwrite itself every time.
+async function warmEngine(): Promise<void> {
+  const { snapshot, restore } = backend;
+  if (!snapshot || !restore || !dictionarySlot) return;
+  const guesses = calculator.getShardWords();
+  const answers = calculator.getDictionary();
+  const priors = calculator.resolvePriors(undefined);
+  const slot = `${backend.name}-${dictionarySlot}${priors ? '-weighted' : ''}`;
+  const key = `${dictionaryKey}-${priorsKey(priors)}`;
+  const cached = await readEngineState(slot, key);
+  if (cached && await restore(cached, guesses, answers, priors)) {
+    console.log(`♻️ Restored engine state for words ${dictionarySlot}${priors ? ' with priors' : ''}`);
+    return;
+  }
+  // Installing these lists is what the first ranking does anyway; the write is not awaited
+  const state = await snapshot(guesses, answers, priors);
+  if (state) writeEngineState(slot, key, state);
+}
+
+async function setDictionary(data: any): Promise<BackendReport> {
+  calculator.setDictionary(data.bytes, data.stride, data.count, data.shardBegin, data.shardEnd);
+  dictionarySlot = `${data.shardBegin}-${data.shardEnd}-${data.count}`;
+  dictionaryKey = `${hashStateBytes(data.bytes)}-${data.stride}`;
+  if (!backendReport) backendReport = chooseBackend(calculator.getDictionary());
+  const report = await backendReport;
+  await warmEngine();
+  return report;
+}
+
+async function setPriors(priors: Float32Array | null) {
+  calculator.setPriors(priors);
+  await backendReport;
+  await warmEngine();
+  return { success: true };
+}
+
+async function rankShard(data: any, onProgress: (progress: RankingProgress) => void, isCancelled: () => boolean) {
+  const answers = calculator.resolveAnswers(data.answerIndices, data.answers);
+  const priors = calculator.resolvePriors(data.answerIndices, data.answers);
+  const board: Board | null = data.constraints ? { constraints: data.constraints, hardMode: !!data.hardMode } : null;
+  return backend.rank(calculator.getShardWords(), answers, priors, data.topK, onProgress, isCancelled, board);
+}
+
+// The running bulk calculation; a newer one supersedes it, and 'cancel' abandons it
+let activeJob: { requestId: string; cancelled: boolean } | null = null;
+
+async function runSlicedCalculation(
+  requestId: string,
+  compute: (onProgress: (progress: RankingProgress) => void, isCancelled: () => boolean) => Promise<any[] | null>
+) {
+  if (activeJob) activeJob.cancelled = true;
+  const job = { requestId, cancelled: false };
+  activeJob = job;
+
+  try {
+    const result = await compute(
+      progress => self.postMessage({ type: 'progress', requestId, progress } as WorkerResponse),
+      () => job.cancelled
+    );
+    self.postMessage((result ? { type: 'success', requestId, result } : { type: 'cancelled', requestId }) as WorkerResponse);
+  } catch (error: any) {
+    console.error('❌ Worker error:', error);
+    self.postMessage({ type: 'error', requestId, error: error.message } as WorkerResponse);
+  } finally {
+    if (activeJob === job) activeJob = null;
+  }
+}
+
+// Posts the outcome of an async request; `transfer` hands a typed array result over
+function respond(requestId: string, result: Promise<any>, transfer = false) {
+  result.then(
+    value => self.postMessage({ type: 'success', requestId, result: value } as WorkerResponse,
+                              transfer && value?.buffer ? [value.buffer] : []),
+    (error: any) => self.postMessage({ type: 'error', requestId, error: error.message } as WorkerResponse)
+  );
+}
+
 // Web Worker message handler with proper typing
 self.onmessage = function(e: MessageEvent<WorkerMessage>) {
   const { type, data, requestId } = e.data;
+
+  if (type === 'calculateAllEntropies') {
+    const guesses = data.allWords ? data.allWords.map((w: string) => w.toUpperCase()) : calculator.getDictionary();
+    const answers = calculator.resolveAnswers(undefined, data.possibleAnswers);
+    runSlicedCalculation(requestId, (onProgress, isCancelled) =>
+      backend.rank(guesses, answers, null, 0, onProgress, isCancelled));
+    return;
+  }
+  if (type === 'calculateShard') {
+    runSlicedCalculation(requestId, (onProgress, isCancelled) => rankShard(data, onProgress, isCancelled));
+    return;
+  }
+  if (type === 'setDictionary') {
+    respond(requestId, setDictionary(data));
+    return;
+  }
+  if (type === 'setPriors') {
+    respond(requestId, setPriors(data.priors));
+    return;
+  }
+  if (type === 'calculateEntropy') {
+    const answers = calculator.resolveAnswers(data.answerIndices, data.possibleAnswers);
+    const priors = calculator.resolvePriors(data.answerIndices, data.possibleAnswers);
+    respond(requestId, backend.entropy(data.word.toUpperCase(), answers, priors));
+    return;
+  }
+  if (type === 'filterWords') {
+    const { knownPositions, yellowLetters, grayLetters } = data;
+    respond(requestId, backend.filter(data.words, { knownPositions, yellowLetters, grayLetters }));
+    return;
+  }
+  if (type === 'filterDictionary') {
+    // Dictionary rows, so the word list is not sent back and forth
+    const answers = calculator.getDictionary();
+    respond(requestId, backend.filterAnswers(calculator.getShardWords(), answers,
+                                             calculator.resolvePriors(undefined), data.constraints), true);
+    return;
+  }
+  if (type === 'cancel') {
+    if (activeJob && activeJob.requestId === data.requestId) activeJob.cancelled = true;
+    return;
+  }
   
   try {
     let result: any;
@@ -199,24 +608,11 @@ self.onmessage = function(e: MessageEvent<WorkerMessage>) {
         calculator.setWordLists(data.allWords, data.possibleAnswers);
         result = { success: true };
         break;
-        
-      case 'calculateEntropy':
-        result = calculator.calculateEntropy(data.word, data.possibleAnswers);
-        break;
-        
-      case 'calculateAllEntropies':
-        result = calculator.calculateAllEntropies(data.allWords, data.possibleAnswers);
-        break;
-        
-      case 'filterWords':
-        result = calculator.filterWords(
-          data.words, 
-          data.knownPositions, 
-          data.yellowLetters, 
-          data.grayLetters
-        );
+
+      case 'getStats':
+        result = backend.stats?.() ?? null;
         break;
-        
+
       default:
         throw new Error(`Unknown message type: ${type}`);
     }
@@ -0,0 +1,172 @@
+// Lazily loaded opening books written by scripts/build-opening-tables.mjs
+// (layout documented next to EntropyCalculator::buildOpeningTable in entropy_engine.h)
+
+export interface OpeningMove {
+  word: string;
+  entropy: number;
+}
+
+export interface SecondMove extends OpeningMove {
+  remaining: number; // answers consistent with the opener's feedback
+}
+
+export interface OpeningTable {
+  wordLength: number;
+  answerCount: number;
+  openers: OpeningMove[];
+  // Opener -> base-3 pattern code (B=0, Y=1, G=2, tile i weighted 3^i) -> best second guess
+  secondMoves: Map<string, Map<number, SecondMove>>;
+}
+
+const OPENING_TABLE_VERSION = 1;
+const HEADER_BYTES = 16;
+
+const tableCache = new Map<number, Promise<OpeningTable | null>>();
+
+// Same encoding as encodePattern in the engine; any tile other than G/Y counts as gray
+export function patternCode(pattern: string): number {
+  let code = 0;
+  let weight = 1;
+  for (const tile of pattern.toUpperCase()) {
+    code += (tile === 'G' ? 2 : tile === 'Y' ? 1 : 0) * weight;
+    weight *= 3;
+  }
+  return code;
+}
+
+export function decodeOpeningTable(buffer: ArrayBuffer): OpeningTable | null {
+  const view = new DataView(buffer);
+  const bytes = new Uint8Array(buffer);
+  if (buffer.byteLength < HEADER_BYTES) return null;
+  const magic = String.fromCharCode(bytes[0], bytes[1], bytes[2], bytes[3]);
+  if (magic !== 'WDLO' || bytes[4] !== OPENING_TABLE_VERSION) return null;
+
+  const wordLength = bytes[5];
+  const openerCount = view.getUint16(6, true);
+  const followUps = view.getUint16(8, true);
+  const answerCount = view.getUint32(12, true);
+  let offset = HEADER_BYTES;
+
+  const readWord = () => {
+    const word = String.fromCharCode(...bytes.subarray(offset, offset + wordLength));
+    offset += wordLength;
+    return word;
+  };
+
+  try {
+    const openers: OpeningMove[] = [];
+    for (let i = 0; i < openerCount; i++) {
+      const word = readWord();
+      openers.push({ word, entropy: view.getFloat32(offset, true) });
+      offset += 4;
+    }
+
+    const secondMoves = new Map<string, Map<number, SecondMove>>();
+    for (let o = 0; o < followUps; o++) {
+      const patterns = new Map<number, SecondMove>();
+      const patternCount = view.getUint32(offset, true);
+      offset += 4;
+      for (let p = 0; p < patternCount; p++) {
+        // Codes reach 3^31, past 32 bits but well inside a double's exact range
+        const code = view.getUint32(offset, true) + view.getUint32(offset + 4, true) * 2 ** 32;
+        const remaining = view.getUint32(offset + 8, true);
+        const entropy = view.getFloat32(offset + 12, true);
+        offset += 16;
+        const word = readWord();
+        // Entropy -1 marks a partition the builder could rank no guess for
+        if (entropy >= 0) patterns.set(code, { word, entropy, remaining });
+      }
+      secondMoves.set(openers[o].word, patterns);
+    }
+    if (offset > buffer.byteLength) return null;
+    return { wordLength, answerCount, openers, secondMoves };
+  } catch {
+    // DataView reads past the end throw RangeError on truncated files
+    return null;
+  }
+}
+
+// Fetches /openings_N_letters.bin once per length; null when the table was not generated
+export function loadOpeningTable(length: number): Promise<OpeningTable | null> {
+  if (!tableCache.has(length)) {
+    const load = (async () => {
+      try {
+        const response = await fetch(`/openings_${length}_letters.bin`);
+        if (!response.ok) return null;
+        const table = decodeOpeningTable(await response.arrayBuffer());
+        if (table && table.wordLength === length) {
+          console.log(`📖 Loaded ${length}-letter opening table (${table.openers.length} openers)`);
+          return table;
+        }
+        return null;
+      } catch (error) {
+        console.warn(`⚠️ No ${length}-letter opening table:`, error);
+        return null;
+      }
+    })();
+    tableCache.set(length, load);
+  }
+  return tableCache.get(length)!;
+}
+
+// Best second guess after playing `opener` and seeing `pattern` (G/Y/B per tile)
+export function getSecondMove(table: OpeningTable, opener: string, pattern: string): SecondMove | null {
+  return table.secondMoves.get(opener.toUpperCase())?.get(patternCode(pattern)) ?? null;
+}
+
+export interface BookMove extends SecondMove {
+  opener: string;
+  pattern: string;
+}
+
+// Feedback `opener` would have produced on this board (G/Y/B per tile), or null when the board
+// holds anything that feedback does not explain, e.g. a second guess was entered as well
+export function patternFromConstraints(
+  opener: string,
+  knownPositions: string[],
+  yellowLetters: Array<{ letter: string; excludedPositions: number[] }>,
+  grayLetters: string[]
+): string | null {
+  if (opener.length !== knownPositions.length) return null;
+  const yellowAt = (letter: string, position: number) =>
+    yellowLetters.some(y => y.letter.toUpperCase() === letter && y.excludedPositions.includes(position));
+  const gray = grayLetters.map(letter => letter.toUpperCase());
+
+  let pattern = '';
+  for (let i = 0; i < opener.length; i++) {
+    const letter = opener[i];
+    if (knownPositions[i] === letter) pattern += 'G';
+    else if (yellowAt(letter, i)) pattern += 'Y';
+    else if (gray.includes(letter)) pattern += 'B';
+    else return null;
+  }
+
+  for (let i = 0; i < knownPositions.length; i++) {
+    if (knownPositions[i] && pattern[i] !== 'G') return null;
+  }
+  for (const { letter, excludedPositions } of yellowLetters) {
+    const upper = letter.toUpperCase();
+    if (excludedPositions.length === 0) return null;
+    if (excludedPositions.some(p => opener[p] !== upper || pattern[p] !== 'Y')) return null;
+  }
+  for (const letter of gray) {
+    if (![...opener].some((tile, i) => tile === letter && pattern[i] === 'B')) return null;
+  }
+  return pattern;
+}
+
+// Book second guess when the board is exactly one table opener's feedback
+export function bookSecondMove(
+  table: OpeningTable,
+  knownPositions: string[],
+  yellowLetters: Array<{ letter: string; excludedPositions: number[] }>,
+  grayLetters: string[]
+): BookMove | null {
+  for (const opener of table.secondMoves.keys()) {
+    const pattern = patternFromConstraints(opener, knownPositions, yellowLetters, grayLetters);
+    if (!pattern) continue;
+    const move = getSecondMove(table, opener, pattern);
+    if (move) return { ...move, opener, pattern };
+  }
+  return null;
+}
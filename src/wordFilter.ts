@@ -0,0 +1,96 @@
+// Board constraints in JS, with the same rules as CompiledConstraints in entropy_engine.h.
+// The engine filters in the workers; this is the fallback that runs before the pool is ready
+// and on the JS backend. Per letter: at least max(greens, yellow entries) copies; a gray
+// letter caps the copies at that minimum (so a gray repeat of a green letter only rules out
+// further copies); greens are fixed and yellows are excluded from their positions.
+
+export interface YellowLetter {
+  letter: string;
+  excludedPositions: number[];
+}
+
+export interface WordConstraints {
+  knownPositions: string[];
+  yellowLetters: YellowLetter[];
+  grayLetters: string[];
+}
+
+export interface CompiledConstraints {
+  length: number;
+  greens: string[];            // letter fixed at each position, or ''
+  excluded: Array<Set<string>>; // letters ruled out at each position
+  minCount: Map<string, number>;
+  maxCount: Map<string, number>; // only letters capped by a gray
+}
+
+export function compileConstraints(length: number, constraints: WordConstraints): CompiledConstraints {
+  const greens = Array.from({ length }, (_, i) => (constraints.knownPositions[i] ?? '').toUpperCase());
+  const excluded = Array.from({ length }, () => new Set<string>());
+  const greenCount = new Map<string, number>();
+  const yellowCount = new Map<string, number>();
+
+  for (const letter of greens) {
+    if (letter) greenCount.set(letter, (greenCount.get(letter) ?? 0) + 1);
+  }
+  for (const { letter, excludedPositions } of constraints.yellowLetters) {
+    const upper = letter.toUpperCase();
+    yellowCount.set(upper, (yellowCount.get(upper) ?? 0) + 1);
+    for (const position of excludedPositions) {
+      if (position >= 0 && position < length) excluded[position].add(upper);
+    }
+  }
+
+  const minCount = new Map<string, number>();
+  for (const letter of new Set([...greenCount.keys(), ...yellowCount.keys()])) {
+    minCount.set(letter, Math.max(greenCount.get(letter) ?? 0, yellowCount.get(letter) ?? 0));
+  }
+  const maxCount = new Map<string, number>();
+  for (const letter of constraints.grayLetters) {
+    const upper = letter.toUpperCase();
+    maxCount.set(upper, minCount.get(upper) ?? 0);
+  }
+  return { length, greens, excluded, minCount, maxCount };
+}
+
+function letterCounts(word: string): Map<string, number> {
+  const counts = new Map<string, number>();
+  for (const letter of word) counts.set(letter, (counts.get(letter) ?? 0) + 1);
+  return counts;
+}
+
+// `word` must be uppercase
+export function matchesConstraints(word: string, compiled: CompiledConstraints): boolean {
+  if (word.length !== compiled.length) return false;
+  for (let i = 0; i < word.length; i++) {
+    if (compiled.greens[i] ? word[i] !== compiled.greens[i] : compiled.excluded[i].has(word[i])) return false;
+  }
+  const counts = letterCounts(word);
+  for (const [letter, min] of compiled.minCount) {
+    if ((counts.get(letter) ?? 0) < min) return false;
+  }
+  for (const [letter, max] of compiled.maxCount) {
+    if ((counts.get(letter) ?? 0) > max) return false;
+  }
+  return true;
+}
+
+// Hard-mode guess rule: greens stay in place and every revealed letter is reused at least as
+// often as revealed; gray letters and yellow positions may be reused
+export function satisfiesHints(word: string, compiled: CompiledConstraints): boolean {
+  if (word.length !== compiled.length) return false;
+  for (let i = 0; i < word.length; i++) {
+    if (compiled.greens[i] && word[i] !== compiled.greens[i]) return false;
+  }
+  const counts = letterCounts(word);
+  for (const [letter, min] of compiled.minCount) {
+    if ((counts.get(letter) ?? 0) < min) return false;
+  }
+  return true;
+}
+
+// Words (any case, returned as given) consistent with the board
+export function filterWords(words: string[], constraints: WordConstraints): string[] {
+  if (words.length === 0) return [];
+  const compiled = compileConstraints(words[0].length, constraints);
+  return words.filter(word => matchesConstraints(word.toUpperCase(), compiled));
+}